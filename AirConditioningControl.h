@@ -0,0 +1,1048 @@
+#ifndef AIRCONDITIONINGCONTROL_AIRCONDITIONINGCONTROL_H
+#define AIRCONDITIONINGCONTROL_AIRCONDITIONINGCONTROL_H
+
+#include <QtWidgets>
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <vector>
+
+#include "Airflow.h"
+#include "CommandJournal.h"
+#include "ControlCore.h"
+#include "FrameTimedView.h"
+#include "Instrumentation.h"
+#include "SensorIngestion.h"
+#include "SettingsStore.h"
+#include "SettingsWriter.h"
+#include "SettingsXml.h"
+#include "TelemetryRing.h"
+#include "Theme.h"
+#include "ThermalRunner.h"
+#include "TraceRecorder.h"
+#include "TrendItem.h"
+#include "Units.h"
+#include "UpdateScheduler.h"
+#include "ValueFormatter.h"
+
+/**
+ * @class AirConditioningControl
+ * @brief Виджет для управления кондиционированием воздуха.
+ *
+ * Виджет не хранит состояние блока сам: команды оператора передаются в
+ * ControlCore, а виджет лишь отображает один блок из общего FleetStore.
+ */
+class AirConditioningControl : public QWidget {
+public:
+    /**
+     * @brief Конструктор класса AirConditioningControl.
+     * @param core Ядро управления блоками.
+     * @param telemetry История показаний блоков.
+     * @param unit Индекс отображаемого блока.
+     * @param parent Указатель на родительский виджет.
+     */
+    explicit AirConditioningControl(ControlCore &core, TelemetryHistory &telemetry, FleetStore::UnitId unit,
+                                    QWidget *parent = nullptr)
+        : QWidget(parent), temperatureScene(new QGraphicsScene(this)), humidityScene(new QGraphicsScene(this)),
+          coordsScene(new QGraphicsScene(this)), core(core), fleet(core.fleet()), telemetry(telemetry), unit(unit) {
+        frameTimer.setSingleShot(true);
+        connect(&frameTimer, &QTimer::timeout, this, &AirConditioningControl::flushUpdates);
+        themeTimer.setSingleShot(true);
+        connect(&themeTimer, &QTimer::timeout, this, &AirConditioningControl::continueTheme);
+        createUI();
+        loadSettings();
+        connect(&checkpointTimer, &QTimer::timeout, this, &AirConditioningControl::checkpointSettings);
+        modeClock.start();
+        telemetryClock.start();
+        connect(&modeTimer, &QTimer::timeout, this, &AirConditioningControl::updateModes);
+        modeTimer.start(modeIntervalMs);
+        connect(&airflowTimer, &QTimer::timeout, this, &AirConditioningControl::animateAirflow);
+        connect(&sampleTimer, &QTimer::timeout, this, &AirConditioningControl::recordSample);
+        sampleTimer.start(sampleIntervalMs);
+        trendSamples.resize(telemetry.ring(unit).capacity());
+        connect(&trendTimer, &QTimer::timeout, this, &AirConditioningControl::refreshTrends);
+        trendTimer.start(trendIntervalMs);
+        connect(&statsTimer, &QTimer::timeout, this, &AirConditioningControl::refreshStatsOverlay);
+        auto *statsShortcut = new QShortcut(QKeySequence(Qt::Key_F12), this);
+        connect(statsShortcut, &QShortcut::activated, this,
+                [this] { setStatsOverlayVisible(statsOverlay->isHidden()); });
+        if (TraceRecorder::enabled())
+            traceSceneChanges();
+    }
+
+    static constexpr int frameIntervalMs = 16; /**< Минимальный интервал между кадрами обновления (~60 кадров/с). */
+    static constexpr int sampleIntervalMs = 100; /**< Период записи показаний в историю (10 Гц). */
+    static constexpr int sensorIntervalMs = 33; /**< Период передачи показаний датчиков в интерфейс (~30 Гц). */
+    static constexpr int modeIntervalMs = 100; /**< Период переходов между режимами работы (10 Гц). */
+    static constexpr int statsIntervalMs = 500; /**< Период обновления отладочной панели замеров. */
+    static constexpr int trendIntervalMs = 16; /**< Период перерисовки графиков (~60 кадров/с). */
+    static constexpr std::size_t themeItemsPerFrame = 2000; /**< Элементов, перекрашиваемых за один кадр. */
+    static constexpr int journalCheckpointSeconds = 60; /**< Период снимков настроек при журнале без --checkpoint. */
+    static constexpr const char *settingsPath = "settings.bin"; /**< Файл двоичных настроек. */
+    static constexpr const char *xmlSettingsPath = "settings.xml"; /**< Файл настроек, переносимых из XML. */
+
+    /**
+     * @brief Подключает прием показаний датчиков.
+     * @param ingestion Фоновый прием показаний; должен существовать дольше виджета.
+     */
+    void attachSensors(SensorIngestion &ingestion) {
+        sensors = &ingestion;
+        connect(&sensorTimer, &QTimer::timeout, this, &AirConditioningControl::applySensorReadings, Qt::UniqueConnection);
+        sensorTimer.start(sensorIntervalMs);
+    }
+
+    /**
+     * @brief Подключает моделирование помещения вместо показаний датчика температуры.
+     *
+     * Модель привязывается к блоку, отображаемому в момент подключения, и
+     * продолжает моделировать именно его после переключения окна на другой блок.
+     *
+     * @param runner Модель помещения в реальном времени; должна существовать дольше виджета.
+     */
+    void attachThermostat(ThermalRunner &runner) {
+        thermostat = &runner;
+        thermostatUnit = unit;
+        connect(&thermostatTimer, &QTimer::timeout, this, &AirConditioningControl::syncThermostat,
+                Qt::UniqueConnection);
+        thermostatTimer.start(sampleIntervalMs);
+    }
+
+    /**
+     * @brief Подключает журнал команд оператора.
+     *
+     * Команды, восстановленные из журнала при открытии, применяются поверх
+     * загруженных настроек; после этого каждая команда оператора (уставка,
+     * питание, направление обдува, качание) дописывается в журнал. Каждый
+     * записанный снимок настроек сокращает журнал до команд, поданных после
+     * кодирования снимка. Если периодическое сохранение не задано, снимки
+     * делаются раз в journalCheckpointSeconds.
+     *
+     * @param commandJournal Журнал команд; должен существовать дольше виджета.
+     */
+    void attachJournal(CommandJournal &commandJournal) {
+        for (const auto &command: commandJournal.recovered())
+            core.applyCommand(command);
+        if (!commandJournal.recovered().empty()) {
+            temperatureSlider->setValue(fleet.setpoint(unit));
+            sweepButton->setChecked(fleet.airflowSweep(unit));
+            scheduleUpdate(UpdateScheduler::Temperature | UpdateScheduler::Power | UpdateScheduler::Mode);
+            startAirflowAnimation();
+            settingsDirty = true;
+        }
+        journal = &commandJournal;
+        // Журнал сокращается только после снимка настроек, поэтому снимки нужны и без --checkpoint.
+        if (!checkpointTimer.isActive())
+            checkpointTimer.start(journalCheckpointSeconds * 1000);
+    }
+
+    /**
+     * @brief Дожидается фоновой записи настроек, запланированной при закрытии окна,
+     * и сокращения журнала после нее.
+     * @return true, если последняя запись прошла успешно.
+     */
+    bool waitForSettings() {
+        return settingsWriter.flush();
+    }
+
+    /**
+     * @brief Применяет все накопленные обновления отображения за один проход.
+     */
+    void flushUpdates() {
+        ScopedLatency latency(Instrumentation::FlushUpdates);
+        quint64 avoided = avoidedInvalidationCount;
+        std::uint32_t parts = updateScheduler.takeDirty();
+        if (parts & UpdateScheduler::Temperature)
+            renderTemperature();
+        if (parts & UpdateScheduler::Pressure)
+            renderPressure();
+        if (parts & UpdateScheduler::Humidity)
+            renderHumidity();
+        if (parts & UpdateScheduler::Power)
+            renderPower();
+        if (parts & UpdateScheduler::Airflow)
+            renderAirflow();
+        if (parts & UpdateScheduler::Mode)
+            renderMode();
+        Instrumentation::count(Instrumentation::SceneUpdates, static_cast<std::uint64_t>(std::popcount(parts)));
+        Instrumentation::count(Instrumentation::SkippedUpdates, avoidedInvalidationCount - avoided);
+    }
+
+    /**
+     * @brief Возвращает количество обновлений, объединенных в общие кадры.
+     * @return Количество объединенных обновлений.
+     */
+    quint64 coalescedUpdates() const {
+        return updateScheduler.coalescedUpdates();
+    }
+
+    /**
+     * @brief Возвращает время построения последнего кадра графиков.
+     * @return Время кадра, мкс.
+     */
+    qint64 trendFrameTimeUs() const {
+        return frameTimeUs;
+    }
+
+    /**
+     * @brief Возвращает количество пропущенных обновлений элементов сцены и подписей.
+     *
+     * Учитываются обновления, при которых текст или геометрия элемента совпали
+     * с уже показанными, поэтому элемент не изменялся и не вызывал перерисовку.
+     *
+     * @return Количество пропущенных обновлений.
+     */
+    quint64 avoidedInvalidations() const {
+        return avoidedInvalidationCount;
+    }
+
+    /**
+     * @brief Применяет параметры отрисовки ко всем графическим представлениям окна.
+     *
+     * При кэшировании неизменные элементы (рамки, оси и их подписи) рисуются
+     * из растрового кэша и перерисовываются только при смене темы.
+     *
+     * @param settings Параметры отрисовки.
+     */
+    void applyRenderSettings(const RenderSettings &settings) {
+        for (auto *view: {temperatureView, humidityView, coordsView})
+            view->applyRenderSettings(settings);
+        auto cacheMode = settings.cacheStatic ? QGraphicsItem::DeviceCoordinateCache : QGraphicsItem::NoCache;
+        for (auto *item: staticItems)
+            item->setCacheMode(cacheMode);
+    }
+
+    /**
+     * @brief Показывает или скрывает отладочную панель замеров.
+     *
+     * Показ панели включает сбор замеров Instrumentation, если он еще выключен.
+     *
+     * @param visible Показывать ли панель.
+     */
+    void setStatsOverlayVisible(bool visible) {
+        if (visible) {
+            Instrumentation::setEnabled(true);
+            refreshStatsOverlay();
+            statsOverlay->show();
+            statsOverlay->raise();
+            statsTimer.start(statsIntervalMs);
+        } else {
+            statsTimer.stop();
+            statsOverlay->hide();
+        }
+    }
+
+    /**
+     * @brief Переключает окно на отображение другого блока парка.
+     * @param newUnit Индекс блока.
+     */
+    void showUnit(FleetStore::UnitId newUnit) {
+        if (newUnit == unit || newUnit >= fleet.size())
+            return;
+        unit = newUnit;
+        renderedPower = -1;
+        renderedMode.reset();
+        trendWindowEndMs = 0;
+        temperatureSlider->setValue(fleet.setpoint(unit));
+        sweepButton->setChecked(fleet.airflowSweep(unit));
+        setWindowTitle(QString("Блок %1").arg(unit + 1));
+        scheduleUpdate(UpdateScheduler::Temperature | UpdateScheduler::Pressure | UpdateScheduler::Humidity |
+                       UpdateScheduler::Power | UpdateScheduler::Airflow | UpdateScheduler::Mode);
+    }
+
+    /**
+     * @brief Задает период фонового сохранения настроек.
+     * @param seconds Период в секундах; 0 отключает периодическое сохранение, а при
+     * подключенном журнале задает период journalCheckpointSeconds, ограничивающий журнал.
+     */
+    void setCheckpointInterval(int seconds) {
+        if (seconds <= 0 && journal)
+            seconds = journalCheckpointSeconds;
+        if (seconds > 0)
+            checkpointTimer.start(seconds * 1000);
+        else
+            checkpointTimer.stop();
+    }
+
+    /**
+     * @brief Экспортирует настройки в XML файл.
+     * @param path Путь к XML файлу.
+     */
+    void saveSettingsToXml(const QString &path) {
+        ScopedLatency latency(Instrumentation::XmlSave);
+        writeSettingsXml(path, displaySettings(), fleet);
+    }
+
+    /**
+     * @brief Импортирует настройки из XML файла.
+     * @param path Путь к XML файлу.
+     * @return true, если файл прочитан.
+     */
+    bool loadSettingsFromXml(const QString &path) {
+        DisplaySettings display = displaySettings();
+        {
+            ScopedLatency latency(Instrumentation::XmlLoad);
+            if (!readSettingsXml(path, display, fleet))
+                return false;
+        }
+        applySettings(display);
+        settingsDirty = true;
+        return true;
+    }
+
+protected:
+    /**
+     * @brief Записывает в трассу события ввода ползунка температуры.
+     * @param watched Объект, которому адресовано событие.
+     * @param event Событие.
+     * @return false: событие передается дальше.
+     */
+    bool eventFilter(QObject *watched, QEvent *event) override {
+        if (watched == temperatureSlider && TraceRecorder::enabled()) {
+            switch (event->type()) {
+                case QEvent::MouseButtonPress:
+                    TraceRecorder::instant("sliderPress", "input");
+                    break;
+                case QEvent::MouseMove:
+                    TraceRecorder::instant("sliderMove", "input");
+                    break;
+                case QEvent::MouseButtonRelease:
+                    TraceRecorder::instant("sliderRelease", "input");
+                    break;
+                case QEvent::KeyPress:
+                    TraceRecorder::instant("sliderKey", "input");
+                    break;
+                case QEvent::Wheel:
+                    TraceRecorder::instant("sliderWheel", "input");
+                    break;
+                default:
+                    break;
+            }
+        }
+        return QWidget::eventFilter(watched, event);
+    }
+
+    /**
+     * @brief Обработчик события закрытия окна.
+     * @param event Событие закрытия.
+     */
+    void closeEvent(QCloseEvent *event) override {
+        checkpointTimer.stop();
+        scheduleSettingsWrite();
+        settingsDirty = false;
+        event->accept();
+    }
+
+public slots:
+    /**
+     * @brief Обновляет уставку температуры.
+     * @param value Новое значение температуры.
+     */
+    void updateTemperature(int value) {
+        ScopedLatency latency(Instrumentation::UpdateTemperature);
+        if (core.setTemperature(unit, value)) {
+            journalCommand(OperatorCommand::Type::SetTemperature, fleet.setpoint(unit));
+            settingsDirty = true;
+            scheduleUpdate(UpdateScheduler::Temperature);
+        }
+    }
+
+    /**
+     * @brief Обновляет единицы измерения температуры.
+     */
+    void updateTemperatureUnits() {
+        ScopedLatency latency(Instrumentation::UpdateTemperatureUnits);
+        settingsDirty = true;
+        scheduleUpdate(UpdateScheduler::Temperature);
+    }
+
+    /**
+     * @brief Обновляет единицы измерения давления.
+     */
+    void updatePressureUnits() {
+        ScopedLatency latency(Instrumentation::UpdatePressureUnits);
+        settingsDirty = true;
+        scheduleUpdate(UpdateScheduler::Pressure);
+    }
+
+    /**
+     * @brief Переключает состояние питания.
+     */
+    void togglePower() {
+        ScopedLatency latency(Instrumentation::TogglePower);
+        journalCommand(OperatorCommand::Type::SetPower, core.togglePower(unit) ? 1 : 0);
+        settingsDirty = true;
+        scheduleUpdate(UpdateScheduler::Power);
+        updateModes();
+    }
+
+    /**
+     * @brief Переключает тему оформления.
+     */
+    void toggleTheme() {
+        ScopedLatency latency(Instrumentation::ToggleTheme);
+        darkTheme = !darkTheme;
+        themeButton->setText(darkTheme ? "Светлая тема" : "Темная тема");
+        applyTheme(darkTheme ? Theme::dark() : Theme::light());
+    }
+
+    /**
+     * @brief Усиливает поток воздуха.
+     */
+    void increaseAirflow() {
+        ScopedLatency latency(Instrumentation::AirflowCommand);
+        airflowChanged(core.changeAirflowStrength(unit, ControlCore::airflowStrengthStep));
+    }
+
+    /**
+     * @brief Ослабляет поток воздуха.
+     */
+    void decreaseAirflow() {
+        ScopedLatency latency(Instrumentation::AirflowCommand);
+        airflowChanged(core.changeAirflowStrength(unit, -ControlCore::airflowStrengthStep));
+    }
+
+    /**
+     * @brief Поворачивает жалюзи против часовой стрелки.
+     */
+    void rotateAirflowLeft() {
+        ScopedLatency latency(Instrumentation::AirflowCommand);
+        airflowChanged(core.rotateAirflow(unit, ControlCore::airflowAngleStep));
+    }
+
+    /**
+     * @brief Поворачивает жалюзи по часовой стрелке.
+     */
+    void rotateAirflowRight() {
+        ScopedLatency latency(Instrumentation::AirflowCommand);
+        airflowChanged(core.rotateAirflow(unit, -ControlCore::airflowAngleStep));
+    }
+
+    /**
+     * @brief Переключает качание жалюзи.
+     */
+    void toggleSweep() {
+        ScopedLatency latency(Instrumentation::AirflowCommand);
+        bool sweep = core.toggleAirflowSweep(unit);
+        journalCommand(OperatorCommand::Type::SetSweep, sweep ? 1 : 0);
+        settingsDirty = true;
+        sweepButton->setChecked(sweep);
+        startAirflowAnimation();
+    }
+
+    /**
+     * @brief Продвигает анимацию направления обдува всех блоков парка на один кадр.
+     *
+     * Один таймер ведет анимацию всего парка и останавливается, когда
+     * отображаемые направления всех блоков совпали с заданными.
+     */
+    void animateAirflow() {
+        ScopedLatency latency(Instrumentation::AirflowFrame);
+        float seconds = std::min(static_cast<float>(airflowClock.restart()) / 1000.0f, 0.1f);
+        if (core.animateAirflow(seconds) == 0)
+            airflowTimer.stop();
+        scheduleUpdate(UpdateScheduler::Airflow);
+    }
+
+private:
+    /**
+     * @brief Отображает уставку температуры в выбранных единицах.
+     */
+    void renderTemperature() {
+        Quantity<Celsius> setpoint(fleet.setpoint(unit));
+        auto unitIndex = static_cast<TemperatureUnit>(temperatureUnitCombo->currentIndex());
+        bool changed = visitTemperatureUnit(unitIndex, [&](auto to) {
+            using To = decltype(to);
+            return temperatureText.format("Температура: ", quantityCast<To>(setpoint).count(), To::suffix);
+        });
+        if (changed)
+            temperatureTextItem->setPlainText(toQString(temperatureText));
+        else
+            ++avoidedInvalidationCount;
+    }
+
+    /**
+     * @brief Отображает давление блока в выбранных единицах.
+     */
+    void renderPressure() {
+        Quantity<Pascal> pressure(fleet.pressure(unit));
+        auto unitIndex = static_cast<PressureUnit>(pressureUnitCombo->currentIndex());
+        bool changed = visitPressureUnit(unitIndex, [&](auto to) {
+            using To = decltype(to);
+            return pressureText.format("", quantityCast<To>(pressure).count(), To::suffix);
+        });
+        if (changed)
+            pressureLabel->setText(toQString(pressureText));
+        else
+            ++avoidedInvalidationCount;
+    }
+
+    /**
+     * @brief Создает строку Qt из текста форматтера.
+     * @param formatter Форматтер подписи.
+     * @return Текст подписи.
+     */
+    static QString toQString(const ValueFormatter &formatter) {
+        return QString::fromUtf8(formatter.text().data(), static_cast<int>(formatter.text().size()));
+    }
+
+    /**
+     * @brief Отображает влажность блока.
+     */
+    void renderHumidity() {
+        if (humidityText.format("Влажность: ", static_cast<long long>(fleet.humidity(unit)), "%"))
+            humidityTextItem->setPlainText(toQString(humidityText));
+        else
+            ++avoidedInvalidationCount;
+    }
+
+    /**
+     * @brief Отображает состояние питания блока.
+     */
+    void renderPower() {
+        int powered = fleet.isPowered(unit) ? 1 : 0;
+        if (renderedPower == powered) {
+            ++avoidedInvalidationCount;
+            return;
+        }
+        renderedPower = powered;
+        powerButton->setText(powered ? "Выключить" : "Включить");
+    }
+
+    /**
+     * @brief Отображает режим работы блока.
+     */
+    void renderMode() {
+        UnitMode mode = core.mode(unit);
+        if (renderedMode == mode) {
+            ++avoidedInvalidationCount;
+            return;
+        }
+        renderedMode = mode;
+        modeLabel->setText(modeName(mode));
+    }
+
+    /**
+     * @brief Возвращает название режима работы для отображения.
+     * @param mode Режим работы.
+     * @return Название режима.
+     */
+    static QString modeName(UnitMode mode) {
+        switch (mode) {
+            case UnitMode::Off:
+                return "Выключен";
+            case UnitMode::Starting:
+                return "Запуск";
+            case UnitMode::Cooling:
+                return "Охлаждение";
+            case UnitMode::Heating:
+                return "Обогрев";
+            case UnitMode::Fan:
+                return "Вентиляция";
+            case UnitMode::Fault:
+                return "Авария";
+        }
+        return {};
+    }
+
+    /**
+     * @brief Выполняет переходы между режимами работы блоков парка.
+     */
+    void updateModes() {
+        ScopedLatency latency(Instrumentation::ModeTick);
+        core.tick(static_cast<double>(modeClock.elapsed()) / 1000.0);
+        if (core.mode(unit) != renderedMode)
+            scheduleUpdate(UpdateScheduler::Mode);
+    }
+
+    /**
+     * @brief Отображает направление обдува блока.
+     */
+    void renderAirflow() {
+        AirflowDirection airflow = core.displayedAirflow(unit);
+        QPointF position(airflow.x(), airflow.y());
+        if (point->pos() == position) {
+            ++avoidedInvalidationCount;
+            return;
+        }
+        point->setPos(position);
+    }
+
+    /**
+     * @brief Помечает части отображения как устаревшие и планирует кадр обновления.
+     * @param parts Набор флагов UpdateScheduler::Part.
+     */
+    void scheduleUpdate(std::uint32_t parts) {
+        TraceRecorder::instant("scheduleUpdate", "scene", "parts", parts);
+        if (updateScheduler.markDirty(parts))
+            frameTimer.start(frameIntervalMs);
+    }
+
+    /**
+     * @brief Отмечает изменение заданного направления обдува и запускает анимацию.
+     * @param changed Изменилось ли направление.
+     */
+    void airflowChanged(bool changed) {
+        if (!changed)
+            return;
+        journalCommand(OperatorCommand::Type::SetAirflow);
+        settingsDirty = true;
+        startAirflowAnimation();
+    }
+
+    /**
+     * @brief Дописывает команду оператора для отображаемого блока в журнал, если он подключен.
+     * @param type Вид команды.
+     * @param value Целое значение команды; направление обдува берется из состояния блока.
+     */
+    void journalCommand(OperatorCommand::Type type, std::int32_t value = 0) {
+        if (!journal)
+            return;
+        OperatorCommand command;
+        command.type = type;
+        command.unit = unit;
+        command.timestampMs = QDateTime::currentMSecsSinceEpoch();
+        command.value = value;
+        command.angle = fleet.airflowAngle(unit);
+        command.strength = fleet.airflowStrength(unit);
+        journal->append(command);
+    }
+
+    /**
+     * @brief Запускает общий таймер анимации направления обдува, если он остановлен.
+     */
+    void startAirflowAnimation() {
+        if (airflowTimer.isActive())
+            return;
+        airflowClock.restart();
+        airflowTimer.start(frameIntervalMs);
+    }
+
+    /**
+     * @brief Переносит накопленные показания датчиков в состояние блоков.
+     */
+    void applySensorReadings() {
+        ScopedLatency latency(Instrumentation::SensorDrain);
+        bool unitChanged = false;
+        sensors->drain(sensorReadings);
+        Instrumentation::count(Instrumentation::SensorReadings, sensorReadings.size());
+        for (const auto &reading: sensorReadings) {
+            if (core.applySensorReading(reading) && reading.unit == unit)
+                unitChanged = true;
+        }
+        if (unitChanged)
+            scheduleUpdate(UpdateScheduler::Pressure | UpdateScheduler::Humidity);
+    }
+
+    /**
+     * @brief Передает уставку и режим моделируемого блока в модель помещения и забирает температуру.
+     */
+    void syncThermostat() {
+        ScopedLatency latency(Instrumentation::ThermostatSync);
+        thermostat->setSetpoint(fleet.setpoint(thermostatUnit));
+        thermostat->setMode(core.mode(thermostatUnit));
+        fleet.setTemperature(thermostatUnit, thermostat->temperature());
+    }
+
+    /**
+     * @brief Записывает текущие показания блока в историю.
+     */
+    void recordSample() {
+        ScopedLatency latency(Instrumentation::RecordSample);
+        TelemetrySample sample;
+        sample.timestampMs = telemetryClock.elapsed();
+        sample.temperature = fleet.temperature(unit);
+        sample.pressure = static_cast<float>(fleet.pressure(unit));
+        sample.humidity = static_cast<float>(fleet.humidity(unit));
+        telemetry.ring(unit).append(sample);
+    }
+
+    /**
+     * @brief Перестраивает графики температуры и влажности по истории показаний.
+     *
+     * Окно графика равно глубине истории блока и сдвигается вместе с текущим временем
+     * шагами в один столбец графика. Пока окно не сдвинулось и новых отсчетов нет,
+     * изображение не может измениться, и история не копируется.
+     */
+    void refreshTrends() {
+        ScopedLatency latency(Instrumentation::RefreshTrends);
+        const TelemetryRing &ring = telemetry.ring(unit);
+        qint64 windowMs = static_cast<qint64>(ring.capacity()) * sampleIntervalMs;
+        qint64 columnMs = std::max<qint64>(1, windowMs / static_cast<qint64>(temperatureTrend->columnCount()));
+        qint64 endMs = (telemetryClock.elapsed() / columnMs + 1) * columnMs;
+        std::uint64_t appended = ring.appended();
+        if (endMs == trendWindowEndMs && appended == trendAppended) {
+            ++avoidedInvalidationCount;
+            return;
+        }
+        trendWindowEndMs = endMs;
+        trendAppended = appended;
+
+        QElapsedTimer frameTimer;
+        frameTimer.start();
+
+        std::span<const TelemetrySample> samples(trendSamples.data(), ring.snapshot(trendSamples));
+        qint64 startMs = endMs - windowMs;
+        if (!temperatureTrend->setSamples(samples, &TelemetrySample::temperature, startMs, endMs))
+            ++avoidedInvalidationCount;
+        if (!humidityTrend->setSamples(samples, &TelemetrySample::humidity, startMs, endMs))
+            ++avoidedInvalidationCount;
+
+        frameTimeUs = frameTimer.nsecsElapsed() / 1000;
+        if (++trendFrames % 30 == 0 && frameTimeText.format("Кадр: ", static_cast<long long>(frameTimeUs), " мкс"))
+            frameTimeItem->setPlainText(toQString(frameTimeText));
+    }
+
+    /**
+     * @brief Передает накопленные изменения настроек на фоновую запись.
+     */
+    void checkpointSettings() {
+        if (!settingsDirty)
+            return;
+        scheduleSettingsWrite();
+        settingsDirty = false;
+    }
+
+    /**
+     * @brief Кодирует текущие настройки и передает образ на фоновую запись.
+     *
+     * После записи образа из журнала удаляются команды, поданные до его кодирования.
+     */
+    void scheduleSettingsWrite() {
+        QByteArray image;
+        {
+            ScopedLatency latency(Instrumentation::SettingsEncode);
+            image = SettingsStore::encode(displaySettings(), fleet);
+        }
+        // Снимок учитывает все команды, поданные до этого момента; после его записи они
+        // больше не нужны журналу.
+        std::function<void()> onCommitted;
+        if (journal)
+            onCommitted = [commandJournal = journal, upTo = journal->sequence()] { commandJournal->checkpoint(upTo); };
+        settingsWriter.schedule(std::move(image), std::move(onCommitted));
+    }
+
+    /**
+     * @brief Записывает в трассу изменения сцен графиков.
+     *
+     * Подключается только при включенной записи трассы: пока к сигналу
+     * QGraphicsScene::changed ничего не подключено, сцена не собирает список
+     * измененных областей.
+     */
+    void traceSceneChanges() {
+        for (auto *scene: {temperatureScene, humidityScene, coordsScene}) {
+            connect(scene, &QGraphicsScene::changed, this, [](const QList<QRectF> &region) {
+                TraceRecorder::instant("sceneChanged", "scene", "rects", region.size());
+            });
+        }
+    }
+
+    /**
+     * @brief Обновляет текст отладочной панели замеров.
+     */
+    void refreshStatsOverlay() {
+        statsOverlay->setText(QString::fromStdString(Instrumentation::report()));
+        statsOverlay->adjustSize();
+    }
+
+    /**
+     * @brief Создает пользовательский интерфейс.
+     */
+    void createUI() {
+        setWindowTitle("Управление кондиционированием");
+        setMaximumSize(1024, 768);
+        setMinimumSize(800, 600);
+        resize(1024, 768);
+
+        auto *mainLayout = new QVBoxLayout;
+        font = QFont("Arial", 16);
+        setFont(font);
+
+        auto *pressureLayout = new QHBoxLayout;
+        auto *pressureLabelText = new QLabel("Давление:");
+        pressureLabel = new QLabel;
+        pressureUnitCombo = new QComboBox;
+        pressureUnitCombo->addItem("Па");
+        pressureUnitCombo->addItem("мм рт. ст.");
+        pressureLayout->addWidget(pressureLabelText);
+        pressureLayout->addWidget(pressureLabel);
+        pressureLayout->addWidget(pressureUnitCombo);
+        mainLayout->addLayout(pressureLayout);
+
+        auto *contentLayout = new QHBoxLayout;
+
+        auto *leftSideLayout = new QVBoxLayout;
+        auto *temperatureLayout = new QHBoxLayout;
+        auto *temperatureLabelText = new QLabel("Температура:");
+        temperatureSlider = new QSlider(Qt::Horizontal);
+        temperatureSlider->setRange(ControlCore::minTemperature, ControlCore::maxTemperature);
+        temperatureSlider->setValue(fleet.setpoint(unit));
+        temperatureUnitCombo = new QComboBox;
+        temperatureUnitCombo->addItem("°C");
+        temperatureUnitCombo->addItem("K");
+        temperatureUnitCombo->addItem("°F");
+        temperatureLayout->addWidget(temperatureLabelText);
+        temperatureLayout->addWidget(temperatureSlider);
+        temperatureLayout->addWidget(temperatureUnitCombo);
+        leftSideLayout->addLayout(temperatureLayout);
+        contentLayout->addLayout(leftSideLayout);
+
+        auto *rightSideLayout = new QVBoxLayout;
+        auto *airflowLabelText = new QLabel("Направление обдува:");
+        auto *airflowButtonsLayout = new QHBoxLayout;
+        strongerButton = new QPushButton("Сильнее");
+        weakerButton = new QPushButton("Слабее");
+        rotateLeftButton = new QPushButton("Против часовой");
+        rotateRightButton = new QPushButton("По часовой");
+        sweepButton = new QPushButton("Качание");
+        sweepButton->setCheckable(true);
+        sweepButton->setChecked(fleet.airflowSweep(unit));
+        airflowButtonsLayout->addWidget(strongerButton);
+        airflowButtonsLayout->addWidget(weakerButton);
+        airflowButtonsLayout->addWidget(rotateLeftButton);
+        airflowButtonsLayout->addWidget(rotateRightButton);
+        airflowButtonsLayout->addWidget(sweepButton);
+        rightSideLayout->addWidget(airflowLabelText);
+        rightSideLayout->addLayout(airflowButtonsLayout);
+        contentLayout->addLayout(rightSideLayout);
+
+        mainLayout->addLayout(contentLayout);
+
+        auto *buttonsLayout = new QHBoxLayout;
+        powerButton = new QPushButton(fleet.isPowered(unit) ? "Выключить" : "Включить");
+        themeButton = new QPushButton("Темная тема");
+        modeLabel = new QLabel;
+        buttonsLayout->addWidget(powerButton);
+        buttonsLayout->addWidget(modeLabel);
+        buttonsLayout->addWidget(themeButton);
+        mainLayout->addLayout(buttonsLayout);
+
+        auto *viewsLayout = new QHBoxLayout;
+        auto *viewsLayout2 = new QVBoxLayout;
+        temperatureView = new FrameTimedView(temperatureScene);
+        humidityView = new FrameTimedView(humidityScene);
+        coordsView = new FrameTimedView(coordsScene);
+        viewsLayout2->addWidget(temperatureView);
+        viewsLayout2->addWidget(humidityView);
+        viewsLayout->addLayout(viewsLayout2);
+        viewsLayout->addWidget(coordsView);
+        temperatureView->setTraceName("paintTemperature");
+        humidityView->setTraceName("paintHumidity");
+        coordsView->setTraceName("paintAirflow");
+
+        temperatureRect = new QGraphicsRectItem(0, 0, 300, 100);
+        temperatureScene->addItem(temperatureRect);
+        themeRegistry.addOutline(temperatureRect);
+        staticItems.push_back(temperatureRect);
+
+        temperatureTrend = new TrendItem(temperatureRect->rect(), ControlCore::minTemperature,
+                                         ControlCore::maxTemperature, temperatureRect);
+        temperatureTrend->setPen(QPen(Qt::green));
+
+        temperatureTextItem = new QGraphicsTextItem(temperatureRect);
+        temperatureTextItem->setFont(font);
+        themeRegistry.addLabel(temperatureTextItem);
+
+        auto *humidityRect = new QGraphicsRectItem(0, 0, 300, 100);
+        humidityScene->addItem(humidityRect);
+        themeRegistry.addOutline(humidityRect);
+        staticItems.push_back(humidityRect);
+
+        humidityTrend = new TrendItem(humidityRect->rect(), ControlCore::minHumidity, ControlCore::maxHumidity,
+                                      humidityRect);
+        humidityTrend->setPen(QPen(Qt::blue));
+
+        humidityTextItem = new QGraphicsTextItem(humidityRect);
+        humidityTextItem->setFont(font);
+        themeRegistry.addLabel(humidityTextItem);
+
+        frameTimeItem = new QGraphicsTextItem(humidityRect);
+        frameTimeItem->setPos(humidityRect->rect().bottomLeft());
+        themeRegistry.addLabel(frameTimeItem);
+
+        auto *xAxis = new QGraphicsLineItem(0, 150, 300, 150);
+        auto *yAxis = new QGraphicsLineItem(150, 0, 150, 300);
+        point = new QGraphicsEllipseItem(145, 145, 10, 10);
+        point->setBrush(QBrush(Qt::red));
+        AirflowDirection airflow = core.displayedAirflow(unit);
+        point->setPos(airflow.x(), airflow.y());
+        coordsScene->addItem(xAxis);
+        coordsScene->addItem(yAxis);
+        coordsScene->addItem(point);
+        themeRegistry.addAxis(xAxis);
+        themeRegistry.addAxis(yAxis);
+        staticItems.push_back(xAxis);
+        staticItems.push_back(yAxis);
+
+        auto *xLabel = new QGraphicsTextItem("X");
+        xLabel->setPos(300, 150);
+        coordsScene->addItem(xLabel);
+        themeRegistry.addLabel(xLabel);
+        staticItems.push_back(xLabel);
+
+        auto *yLabel = new QGraphicsTextItem("Y");
+        yLabel->setPos(150, 0);
+        coordsScene->addItem(yLabel);
+        themeRegistry.addLabel(yLabel);
+        staticItems.push_back(yLabel);
+
+        mainLayout->addLayout(viewsLayout);
+        setLayout(mainLayout);
+
+        statsOverlay = new QLabel(this);
+        statsOverlay->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        statsOverlay->setStyleSheet("background-color: rgba(0, 0, 0, 180); color: white; padding: 4px;");
+        statsOverlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+        statsOverlay->hide();
+
+        connect(temperatureSlider, &QSlider::valueChanged, this, &AirConditioningControl::updateTemperature);
+        temperatureSlider->installEventFilter(this);
+        connect(temperatureUnitCombo, static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this,
+                &AirConditioningControl::updateTemperatureUnits);
+        connect(pressureUnitCombo, static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this,
+                &AirConditioningControl::updatePressureUnits);
+        connect(powerButton, &QPushButton::clicked, this, &AirConditioningControl::togglePower);
+        connect(themeButton, &QPushButton::clicked, this, &AirConditioningControl::toggleTheme);
+        connect(strongerButton, &QPushButton::clicked, this, &AirConditioningControl::increaseAirflow);
+        connect(weakerButton, &QPushButton::clicked, this, &AirConditioningControl::decreaseAirflow);
+        connect(rotateLeftButton, &QPushButton::clicked, this, &AirConditioningControl::rotateAirflowLeft);
+        connect(rotateRightButton, &QPushButton::clicked, this, &AirConditioningControl::rotateAirflowRight);
+        connect(sweepButton, &QPushButton::clicked, this, &AirConditioningControl::toggleSweep);
+
+        renderTemperature();
+        renderPressure();
+        renderHumidity();
+    }
+
+    /**
+     * @brief Применяет тему оформления к окну и элементам сцен.
+     * @param theme Тема оформления.
+     */
+    void applyTheme(const Theme &theme) {
+        setPalette(theme.palette());
+        themeRegistry.begin(theme);
+        continueTheme();
+    }
+
+    /**
+     * @brief Перекрашивает очередную порцию элементов сцен и планирует следующую.
+     *
+     * За кадр перекрашивается не больше themeItemsPerFrame элементов, чтобы
+     * смена темы на большом количестве элементов не задерживала интерфейс.
+     */
+    void continueTheme() {
+        ScopedLatency latency(Instrumentation::ThemeStep);
+        if (!themeRegistry.step(themeItemsPerFrame))
+            themeTimer.start(frameIntervalMs);
+    }
+
+    /**
+     * @brief Загружает настройки из двоичного хранилища.
+     *
+     * Если двоичного файла еще нет, настройки переносятся из xmlSettingsPath.
+     */
+    void loadSettings() {
+        ScopedLatency latency(Instrumentation::SettingsLoad);
+        DisplaySettings display;
+        if (settingsStore.load(display, fleet))
+            applySettings(display);
+        else
+            loadSettingsFromXml(xmlSettingsPath);
+    }
+
+    /**
+     * @brief Возвращает текущие настройки отображения.
+     * @return Настройки отображения.
+     */
+    DisplaySettings displaySettings() const {
+        DisplaySettings display;
+        display.temperatureUnit = temperatureUnitCombo->currentIndex();
+        display.pressureUnit = pressureUnitCombo->currentIndex();
+        return display;
+    }
+
+    /**
+     * @brief Применяет загруженные настройки к элементам интерфейса.
+     * @param display Настройки отображения.
+     */
+    void applySettings(const DisplaySettings &display) {
+        temperatureUnitCombo->setCurrentIndex(display.temperatureUnit);
+        pressureUnitCombo->setCurrentIndex(display.pressureUnit);
+        temperatureSlider->setValue(fleet.setpoint(unit));
+        sweepButton->setChecked(fleet.airflowSweep(unit));
+        scheduleUpdate(UpdateScheduler::Temperature | UpdateScheduler::Power | UpdateScheduler::Mode);
+        startAirflowAnimation();
+    }
+
+    QGraphicsScene *temperatureScene; /**< Сцена для отображения температуры. */
+    QGraphicsScene *humidityScene; /**< Сцена для отображения влажности. */
+    QGraphicsScene *coordsScene; /**< Сцена для отображения направления обдува. */
+    FrameTimedView *temperatureView; /**< Виджет для отображения temperatureScene. */
+    FrameTimedView *humidityView; /**< Виджет для отображения humidityScene. */
+    FrameTimedView *coordsView; /**< Виджет для отображения coordsScene. */
+    std::vector<QGraphicsItem *> staticItems; /**< Неизменные элементы сцен (рамки, оси, подписи осей). */
+    QSlider *temperatureSlider; /**< Ползунок для управления температурой. */
+    QPushButton *strongerButton; /**< Кнопка для усиления потока воздуха. */
+    QPushButton *weakerButton; /**< Кнопка для ослабления потока воздуха. */
+    QPushButton *rotateLeftButton; /**< Кнопка для поворота жалюзи против часовой стрелки. */
+    QPushButton *rotateRightButton; /**< Кнопка для поворота жалюзи по часовой стрелке. */
+    QPushButton *sweepButton; /**< Кнопка для включения качания жалюзи. */
+    QPushButton *powerButton; /**< Кнопка для управления питанием. */
+    QLabel *modeLabel; /**< Лейбл для отображения режима работы. */
+    QPushButton *themeButton; /**< Кнопка для переключения темы. */
+    QComboBox *temperatureUnitCombo; /**< Выпадающий список для выбора единиц температуры. */
+    QComboBox *pressureUnitCombo; /**< Выпадающий список для выбора единиц давления. */
+    QGraphicsTextItem *temperatureTextItem; /**< Текстовый элемент для отображения температуры. */
+    QLabel *pressureLabel; /**< Лейбл для отображения давления. */
+    QGraphicsTextItem *humidityTextItem; /**< Текстовый элемент для отображения влажности. */
+    ValueFormatter temperatureText; /**< Текст подписи температуры. */
+    ValueFormatter pressureText; /**< Текст подписи давления. */
+    ValueFormatter humidityText; /**< Текст подписи влажности. */
+    ValueFormatter frameTimeText; /**< Текст подписи времени кадра графиков. */
+    QGraphicsRectItem *temperatureRect; /**< Прямоугольник для отображения температуры. */
+    TrendItem *temperatureTrend; /**< График истории температуры. */
+    TrendItem *humidityTrend; /**< График истории влажности. */
+    QGraphicsTextItem *frameTimeItem; /**< Текстовый элемент для отображения времени кадра графиков. */
+    QGraphicsEllipseItem *point; /**< Точка для отображения направления обдува. */
+    QFont font; /**< Основная тема текста. */
+    ThemeRegistry themeRegistry; /**< Элементы сцен, окрашиваемые по теме. */
+    QTimer themeTimer; /**< Таймер продолжения перекраски элементов по кадрам. */
+    QLabel *statsOverlay; /**< Отладочная панель замеров длительности обработчиков. */
+    QTimer statsTimer; /**< Таймер обновления отладочной панели замеров. */
+
+    ControlCore &core; /**< Ядро управления блоками. */
+    FleetStore &fleet; /**< Хранилище состояния блоков. */
+    TelemetryHistory &telemetry; /**< История показаний блоков. */
+    FleetStore::UnitId unit; /**< Индекс отображаемого блока. */
+    UpdateScheduler updateScheduler; /**< Накопитель отложенных обновлений отображения. */
+    QTimer frameTimer; /**< Таймер кадра обновления отображения. */
+    SettingsStore settingsStore{settingsPath}; /**< Двоичное хранилище настроек. */
+    SettingsWriter settingsWriter{settingsStore}; /**< Фоновая запись настроек. */
+    QTimer checkpointTimer; /**< Таймер периодического сохранения настроек. */
+    CommandJournal *journal = nullptr; /**< Журнал команд оператора. */
+    bool settingsDirty = false; /**< Есть ли несохраненные изменения настроек. */
+    QTimer sampleTimer; /**< Таймер записи показаний в историю. */
+    SensorIngestion *sensors = nullptr; /**< Фоновый прием показаний датчиков. */
+    QTimer sensorTimer; /**< Таймер передачи показаний датчиков в интерфейс. */
+    ThermalRunner *thermostat = nullptr; /**< Модель помещения в реальном времени. */
+    FleetStore::UnitId thermostatUnit = 0; /**< Блок, моделируемый thermostat. */
+    QTimer thermostatTimer; /**< Таймер обмена данными с моделью помещения. */
+    std::vector<SensorReading> sensorReadings; /**< Буфер показаний, забранных у приема. */
+    QTimer trendTimer; /**< Таймер перерисовки графиков. */
+    std::vector<TelemetrySample> trendSamples; /**< Буфер копии истории для построения графиков. */
+    qint64 frameTimeUs = 0; /**< Время построения последнего кадра графиков, мкс. */
+    quint64 trendFrames = 0; /**< Количество построенных кадров графиков. */
+    qint64 trendWindowEndMs = 0; /**< Правый край окна, по которому построены графики, мс. */
+    std::uint64_t trendAppended = 0; /**< Количество отсчетов в истории на момент построения графиков. */
+    int renderedPower = -1; /**< Показанное состояние питания (-1 — еще не показано). */
+    std::optional<UnitMode> renderedMode; /**< Показанный режим работы. */
+    QElapsedTimer modeClock; /**< Монотонные часы для переходов между режимами. */
+    QElapsedTimer telemetryClock; /**< Монотонные часы меток времени истории показаний. */
+    QTimer modeTimer; /**< Таймер переходов между режимами работы. */
+    bool darkTheme = false; /**< Включена ли темная тема. */
+    QTimer airflowTimer; /**< Общий таймер анимации направления обдува всех блоков. */
+    QElapsedTimer airflowClock; /**< Время с предыдущего кадра анимации обдува. */
+    quint64 avoidedInvalidationCount = 0; /**< Количество пропущенных обновлений элементов отображения. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_AIRCONDITIONINGCONTROL_H
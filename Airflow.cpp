@@ -0,0 +1,81 @@
+#include "Airflow.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+static constexpr float degreesToRadians = std::numbers::pi_v<float> / 180.0f;
+static constexpr float settledAngle = 0.05f; /**< Отклонение угла, при котором анимация завершена, градусы. */
+static constexpr float settledStrength = 0.001f; /**< Отклонение силы потока, при котором анимация завершена. */
+
+float normalizeAngle(float degrees) {
+    float angle = std::fmod(degrees, 360.0f);
+    return angle < 0.0f ? angle + 360.0f : angle;
+}
+
+AirflowDirection AirflowDirection::fromVector(float x, float y) {
+    AirflowDirection direction;
+    direction.strength = std::min(std::hypot(x, y) / airflowRange, 1.0f);
+    direction.angle = direction.strength > 0.0f ? normalizeAngle(std::atan2(-y, x) / degreesToRadians) : 0.0f;
+    return direction;
+}
+
+float AirflowDirection::x() const {
+    return strength * airflowRange * std::cos(angle * degreesToRadians);
+}
+
+float AirflowDirection::y() const {
+    return -strength * airflowRange * std::sin(angle * degreesToRadians);
+}
+
+void AirflowAnimator::resize(const FleetStore &fleet) {
+    std::size_t first = angleColumn.size();
+    angleColumn.resize(fleet.size());
+    strengthColumn.resize(fleet.size());
+    phaseColumn.resize(fleet.size(), 0.0f);
+    for (std::size_t i = first; i < fleet.size(); ++i) {
+        auto unit = static_cast<FleetStore::UnitId>(i);
+        angleColumn[i] = fleet.airflowAngle(unit);
+        strengthColumn[i] = fleet.airflowStrength(unit);
+    }
+}
+
+std::size_t AirflowAnimator::advance(const FleetStore &fleet, float seconds) {
+    if (angleColumn.size() != fleet.size())
+        resize(fleet);
+
+    const std::size_t count = fleet.size();
+    const float follow = 1.0f - std::exp(-seconds / smoothingSeconds);
+    const float phaseStep = 2.0f * std::numbers::pi_v<float> * seconds / sweepSeconds;
+    std::span<const float> targetAngles = fleet.airflowAngles();
+    std::span<const float> targetStrengths = fleet.airflowStrengths();
+    std::span<const std::uint8_t> sweeps = fleet.airflowSweeps();
+    float *angles = angleColumn.data();
+    float *strengths = strengthColumn.data();
+    float *phases = phaseColumn.data();
+    std::size_t moving = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        float target = targetAngles[i];
+        if (sweeps[i]) {
+            phases[i] = std::fmod(phases[i] + phaseStep, 2.0f * std::numbers::pi_v<float>);
+            target += sweepAmplitude * std::sin(phases[i]);
+        } else {
+            phases[i] = 0.0f;
+        }
+        // Разность углов по кратчайшей дуге, (-180, 180].
+        float angleError = target - angles[i];
+        angleError -= 360.0f * std::round(angleError / 360.0f);
+        float strengthError = targetStrengths[i] - strengths[i];
+
+        if (std::abs(angleError) <= settledAngle && std::abs(strengthError) <= settledStrength) {
+            angles[i] = target;
+            strengths[i] = targetStrengths[i];
+        } else {
+            angles[i] = normalizeAngle(angles[i] + angleError * follow);
+            strengths[i] += strengthError * follow;
+        }
+        moving += sweeps[i] || angles[i] != target || strengths[i] != targetStrengths[i] ? 1 : 0;
+    }
+    return moving;
+}
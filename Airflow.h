@@ -0,0 +1,89 @@
+#ifndef AIRCONDITIONINGCONTROL_AIRFLOW_H
+#define AIRCONDITIONINGCONTROL_AIRFLOW_H
+
+#include <cstddef>
+#include <vector>
+
+#include "FleetStore.h"
+
+static constexpr float airflowRange = 150.0f; /**< Смещение точки обдува при полной силе потока, единиц сцены. */
+
+/**
+ * @struct AirflowDirection
+ * @brief Направление обдува: угол поворота жалюзи и сила потока.
+ *
+ * Угол отсчитывается в градусах против часовой стрелки от оси X, сила
+ * потока лежит в диапазоне [0, 1]. В координатах сцены (ось Y вниз) поток
+ * изображается вектором длиной strength * airflowRange.
+ */
+struct AirflowDirection {
+    float angle = 0.0f; /**< Угол, градусы в диапазоне [0, 360). */
+    float strength = 0.0f; /**< Сила потока, [0, 1]. */
+
+    /**
+     * @brief Строит направление по смещению точки обдува в координатах сцены.
+     * @param x Смещение по оси X.
+     * @param y Смещение по оси Y (вниз — положительное).
+     * @return Направление обдува; сила ограничивается единицей.
+     */
+    static AirflowDirection fromVector(float x, float y);
+
+    /* Смещение точки обдува в координатах сцены. */
+    float x() const;
+    float y() const;
+};
+
+/**
+ * @brief Приводит угол к диапазону [0, 360).
+ * @param degrees Угол, градусы.
+ * @return Угол в диапазоне [0, 360).
+ */
+float normalizeAngle(float degrees);
+
+/**
+ * @class AirflowAnimator
+ * @brief Плавное движение отображаемого направления обдува всех блоков.
+ *
+ * Заданное направление хранится в FleetStore, а отображаемое — в столбцах
+ * аниматора и догоняет заданное по экспоненте с постоянной времени
+ * smoothingSeconds; угол поворачивается по кратчайшей дуге. В режиме
+ * качания к заданному углу добавляется синусоида с амплитудой sweepAmplitude
+ * и периодом sweepSeconds. Один вызов advance() продвигает весь парк, поэтому
+ * анимацию всех блоков ведет один общий таймер.
+ */
+class AirflowAnimator {
+public:
+    static constexpr float smoothingSeconds = 0.15f; /**< Постоянная времени сглаживания, с. */
+    static constexpr float sweepAmplitude = 30.0f; /**< Амплитуда качания жалюзи, градусы. */
+    static constexpr float sweepSeconds = 8.0f; /**< Период качания жалюзи, с. */
+
+    /**
+     * @brief Задает количество блоков; новые блоки сразу отображаются в заданном направлении.
+     * @param fleet Хранилище состояния блоков.
+     */
+    void resize(const FleetStore &fleet);
+
+    /**
+     * @brief Продвигает анимацию всех блоков.
+     * @param fleet Хранилище состояния блоков.
+     * @param seconds Время, прошедшее с предыдущего вызова, с.
+     * @return Количество блоков, направление которых еще меняется.
+     */
+    std::size_t advance(const FleetStore &fleet, float seconds);
+
+    /**
+     * @brief Возвращает отображаемое направление обдува блока.
+     * @param unit Индекс блока.
+     * @return Направление обдува.
+     */
+    AirflowDirection displayed(FleetStore::UnitId unit) const {
+        return {normalizeAngle(angleColumn[unit]), strengthColumn[unit]};
+    }
+
+private:
+    std::vector<float> angleColumn; /**< Отображаемый угол, градусы. */
+    std::vector<float> strengthColumn; /**< Отображаемая сила потока. */
+    std::vector<float> phaseColumn; /**< Фаза качания, радианы. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_AIRFLOW_H
@@ -0,0 +1,284 @@
+#include "CommandJournal.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#include "Instrumentation.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+ * Заголовок:
+ *   0  uint32 magic
+ *   4  uint32 version
+ * Запись (все числа little-endian):
+ *   0  uint8  type
+ *   1  uint8  0 (резерв, 3 байта)
+ *   4  uint32 unit
+ *   8  int64  timestampMs
+ *   16 int32  value
+ *   20 float  angle
+ *   24 float  strength
+ *   28 uint32 CRC-32 байтов 0..27
+ */
+
+namespace {
+
+constexpr std::array<std::uint32_t, 256> crcTable = [] {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        table[i] = crc;
+    }
+    return table;
+}();
+
+std::uint32_t crc32(const std::uint8_t *data, std::size_t size) {
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < size; ++i)
+        crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void put32(std::uint8_t *data, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+        data[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+void put64(std::uint8_t *data, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i)
+        data[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+std::uint32_t get32(const std::uint8_t *data) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+    return value;
+}
+
+std::uint64_t get64(const std::uint8_t *data) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+        value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    return value;
+}
+
+/**
+ * @brief Сбрасывает буферы файла и дожидается записи данных на носитель.
+ * @param file Открытый файл.
+ * @return true, если данные записаны.
+ */
+bool syncFile(std::FILE *file) {
+    if (std::fflush(file) != 0)
+        return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+} // namespace
+
+CommandJournal::CommandJournal(std::string path, std::chrono::milliseconds commitInterval)
+    : path(std::move(path)), commitInterval(commitInterval) {
+    recover();
+    thread = std::thread(&CommandJournal::run, this);
+}
+
+CommandJournal::~CommandJournal() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    thread.join();
+    if (file)
+        std::fclose(file);
+}
+
+void CommandJournal::encode(const OperatorCommand &command, std::uint8_t *record) {
+    record[0] = static_cast<std::uint8_t>(command.type);
+    record[1] = record[2] = record[3] = 0;
+    put32(record + 4, command.unit);
+    put64(record + 8, static_cast<std::uint64_t>(command.timestampMs));
+    put32(record + 16, static_cast<std::uint32_t>(command.value));
+    put32(record + 20, std::bit_cast<std::uint32_t>(command.angle));
+    put32(record + 24, std::bit_cast<std::uint32_t>(command.strength));
+    put32(record + 28, crc32(record, 28));
+}
+
+bool CommandJournal::decode(const std::uint8_t *record, OperatorCommand &command) {
+    if (get32(record + 28) != crc32(record, 28))
+        return false;
+    if (record[0] < static_cast<std::uint8_t>(OperatorCommand::Type::SetTemperature) ||
+        record[0] > static_cast<std::uint8_t>(OperatorCommand::Type::SetSweep))
+        return false;
+    command.type = static_cast<OperatorCommand::Type>(record[0]);
+    command.unit = get32(record + 4);
+    command.timestampMs = static_cast<std::int64_t>(get64(record + 8));
+    command.value = static_cast<std::int32_t>(get32(record + 16));
+    command.angle = std::bit_cast<float>(get32(record + 20));
+    command.strength = std::bit_cast<float>(get32(record + 24));
+    return true;
+}
+
+void CommandJournal::append(const OperatorCommand &command) {
+    {
+        std::lock_guard lock(mutex);
+        std::size_t offset = pending.size();
+        pending.resize(offset + recordSize);
+        encode(command, pending.data() + offset);
+        ++appended;
+    }
+    wakeUp.notify_one();
+}
+
+bool CommandJournal::flush() {
+    {
+        std::unique_lock lock(mutex);
+        std::uint64_t target = appended;
+        if (processed < target) {
+            flushRequested = true;
+            wakeUp.notify_one();
+        }
+        committed.wait(lock, [&] { return processed >= target; });
+    }
+    std::lock_guard fileLock(fileMutex);
+    return !damaged;
+}
+
+std::uint64_t CommandJournal::sequence() const {
+    std::lock_guard lock(mutex);
+    return appended;
+}
+
+bool CommandJournal::checkpoint(std::uint64_t upTo) {
+    flush();
+    std::lock_guard fileLock(fileMutex);
+    auto count = std::min<std::uint64_t>(upTo - std::min(upTo, fileStart), records.size() / recordSize);
+    if (count == 0)
+        return true;
+    records.erase(records.begin(), records.begin() + static_cast<std::ptrdiff_t>(count * recordSize));
+    fileStart += count;
+    // Новый файл собирается из копии в памяти, поэтому в него попадают и
+    // команды, запись которых в старый файл не удалась.
+    damaged = !rewrite();
+    return !damaged;
+}
+
+std::uint64_t CommandJournal::commits() const {
+    std::lock_guard lock(mutex);
+    return commitCount;
+}
+
+std::uint64_t CommandJournal::failedCommits() const {
+    std::lock_guard lock(mutex);
+    return failed;
+}
+
+void CommandJournal::recover() {
+    std::vector<std::uint8_t> data;
+    {
+        // Файл читается одним вызовом read, а не посимвольно через istreambuf_iterator.
+        std::ifstream input(path, std::ios::binary | std::ios::ate);
+        std::streamoff size = input ? static_cast<std::streamoff>(input.tellg()) : 0;
+        if (size > 0) {
+            data.resize(static_cast<std::size_t>(size));
+            input.seekg(0);
+            input.read(reinterpret_cast<char *>(data.data()), size);
+            data.resize(static_cast<std::size_t>(input.gcount()));
+        }
+    }
+    if (data.size() < headerSize || get32(data.data()) != magic || get32(data.data() + 4) != version) {
+        damaged = !rewrite();
+        return;
+    }
+
+    std::size_t valid = headerSize;
+    OperatorCommand command;
+    while (valid + recordSize <= data.size() && decode(data.data() + valid, command)) {
+        recoveredCommands.push_back(command);
+        valid += recordSize;
+    }
+    records.assign(data.begin() + headerSize, data.begin() + static_cast<std::ptrdiff_t>(valid));
+    appended = processed = recoveredCommands.size();
+    // Оборванная или испорченная при сбое запись и все после нее отбрасываются,
+    // чтобы новые записи шли сразу за последней корректной.
+    std::error_code error;
+    if (valid < data.size())
+        std::filesystem::resize_file(path, valid, error);
+    file = error ? nullptr : std::fopen(path.c_str(), "ab");
+    damaged = file == nullptr;
+}
+
+bool CommandJournal::rewrite() {
+    std::string temporary = path + ".tmp";
+    std::FILE *output = std::fopen(temporary.c_str(), "wb");
+    if (!output)
+        return false;
+    std::array<std::uint8_t, headerSize> header{};
+    put32(header.data(), magic);
+    put32(header.data() + 4, version);
+    bool written = std::fwrite(header.data(), 1, header.size(), output) == header.size() &&
+                   std::fwrite(records.data(), 1, records.size(), output) == records.size() && syncFile(output);
+    written = std::fclose(output) == 0 && written;
+
+    // Открытый файл нельзя заменить в Windows, поэтому он закрывается до переименования
+    // и открывается снова — новый или, при ошибке, прежний.
+    if (file)
+        std::fclose(file);
+    std::error_code error;
+    if (written)
+        std::filesystem::rename(temporary, path, error);
+    if (!written || error)
+        std::filesystem::remove(temporary, error);
+    file = std::fopen(path.c_str(), "ab");
+    return written && !error && file;
+}
+
+void CommandJournal::run() {
+    Instrumentation::setThreadName("journal");
+    std::vector<std::uint8_t> batch;
+    std::unique_lock lock(mutex);
+    for (;;) {
+        wakeUp.wait(lock, [this] { return !pending.empty() || stopping; });
+        if (pending.empty())
+            return;
+        // Окно групповой фиксации: команды, пришедшие за него, попадут в тот же fsync.
+        wakeUp.wait_for(lock, commitInterval, [this] { return flushRequested || stopping; });
+        flushRequested = false;
+
+        batch.clear();
+        batch.swap(pending);
+        std::uint64_t upTo = appended;
+        lock.unlock();
+
+        bool written;
+        {
+            ScopedLatency latency(Instrumentation::JournalCommit);
+            std::lock_guard fileLock(fileMutex);
+            records.insert(records.end(), batch.begin(), batch.end());
+            written = file && std::fwrite(batch.data(), 1, batch.size(), file) == batch.size() && syncFile(file);
+            damaged = damaged || !written;
+        }
+
+        lock.lock();
+        ++commitCount;
+        if (!written)
+            ++failed;
+        processed = upTo;
+        committed.notify_all();
+    }
+}
@@ -0,0 +1,166 @@
+#ifndef AIRCONDITIONINGCONTROL_COMMANDJOURNAL_H
+#define AIRCONDITIONINGCONTROL_COMMANDJOURNAL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "OperatorCommand.h"
+
+/**
+ * @class CommandJournal
+ * @brief Двоичный журнал команд оператора с дозаписью в конец и групповой фиксацией.
+ *
+ * append() только кодирует команду в буфер и сразу возвращает управление.
+ * Поток записи собирает команды, поступившие за commitInterval, и фиксирует
+ * их одной записью и одним fsync, поэтому тысячи команд в секунду стоят
+ * единиц fsync, а задержка до фиксации ограничена commitInterval плюс время
+ * fsync.
+ *
+ * Файл состоит из заголовка и записей фиксированного размера с CRC-32.
+ * При открытии журнал читается целиком, корректные записи становятся
+ * доступны через recovered(), а оборванный при сбое хвост отрезается.
+ *
+ * Команды нумеруются по порядку, начиная с восстановленных. Когда снимок
+ * настроек, учитывающий команды до некоторого номера, записан на диск,
+ * checkpoint() удаляет эти команды из файла, поэтому журнал не растет
+ * дольше, чем между двумя снимками.
+ *
+ * Для сокращения без чтения файла журнал держит в памяти копию записей
+ * файла, поэтому и файл, и память занимают 32 байта на команду, поданную с
+ * последнего снимка: при 1000 команд/с и снимках раз в минуту — около 2 МБ.
+ * checkpoint() переписывает и фиксирует только эти записи, поэтому снимки
+ * должны делаться периодически, а не только при завершении.
+ */
+class CommandJournal {
+public:
+    static constexpr std::uint32_t magic = 0x4A434341; /**< Сигнатура файла ("ACCJ"). */
+    static constexpr std::uint32_t version = 1; /**< Версия формата. */
+    static constexpr std::size_t headerSize = 8; /**< Размер заголовка, байт. */
+    static constexpr std::size_t recordSize = 32; /**< Размер записи, байт. */
+    static constexpr std::chrono::milliseconds defaultCommitInterval{5}; /**< Окно групповой фиксации. */
+
+    /**
+     * @brief Конструктор класса CommandJournal; восстанавливает журнал и запускает поток записи.
+     * @param path Путь к файлу журнала; создается, если его нет.
+     * @param commitInterval Окно групповой фиксации.
+     */
+    explicit CommandJournal(std::string path, std::chrono::milliseconds commitInterval = defaultCommitInterval);
+
+    /**
+     * @brief Деструктор класса CommandJournal; фиксирует оставшиеся команды и останавливает поток.
+     */
+    ~CommandJournal();
+
+    CommandJournal(const CommandJournal &) = delete;
+    CommandJournal &operator=(const CommandJournal &) = delete;
+
+    /**
+     * @brief Возвращает команды, прочитанные из журнала при открытии, от старых к новым.
+     * @return Восстановленные команды.
+     */
+    const std::vector<OperatorCommand> &recovered() const { return recoveredCommands; }
+
+    /**
+     * @brief Добавляет команду в очередь на фиксацию.
+     * @param command Команда.
+     */
+    void append(const OperatorCommand &command);
+
+    /**
+     * @brief Дожидается фиксации всех добавленных команд.
+     * @return true, если все записи и fsync после последней замены файла прошли успешно.
+     */
+    bool flush();
+
+    /**
+     * @brief Возвращает номер, который получит следующая добавленная команда.
+     * @return Количество команд в журнале с момента его создания.
+     */
+    std::uint64_t sequence() const;
+
+    /**
+     * @brief Удаляет из файла команды, учтенные в записанном снимке настроек.
+     *
+     * Вызывается после того, как снимок настроек, закодированный при
+     * sequence() == upTo, записан на диск. Команды с меньшими номерами больше
+     * не нужны для восстановления; более новые команды переносятся в новый
+     * файл, который атомарно заменяет старый. Может вызываться из любого
+     * потока, в том числе одновременно с append().
+     *
+     * @param upTo Номер первой команды, не учтенной в снимке.
+     * @return true, если журнал сокращен или сокращать нечего.
+     */
+    bool checkpoint(std::uint64_t upTo);
+
+    /**
+     * @brief Возвращает количество выполненных групповых фиксаций (вызовов fsync).
+     * @return Количество фиксаций.
+     */
+    std::uint64_t commits() const;
+
+    /**
+     * @brief Возвращает количество неудачных фиксаций.
+     * @return Количество ошибок записи.
+     */
+    std::uint64_t failedCommits() const;
+
+    /**
+     * @brief Кодирует команду в запись журнала.
+     * @param command Команда.
+     * @param record Буфер записи размером recordSize.
+     */
+    static void encode(const OperatorCommand &command, std::uint8_t *record);
+
+    /**
+     * @brief Декодирует запись журнала.
+     * @param record Запись размером recordSize.
+     * @param command Команда.
+     * @return false, если контрольная сумма или вид команды не сходятся.
+     */
+    static bool decode(const std::uint8_t *record, OperatorCommand &command);
+
+private:
+    /**
+     * @brief Читает журнал, отрезает оборванный хвост и открывает файл для дозаписи.
+     */
+    void recover();
+
+    /**
+     * @brief Атомарно заменяет файл журнала заголовком и записями из records и открывает его для дозаписи.
+     * @return true, если новый файл записан, зафиксирован и открыт.
+     */
+    bool rewrite();
+
+    /**
+     * @brief Цикл потока записи.
+     */
+    void run();
+
+    std::string path; /**< Путь к файлу журнала. */
+    std::chrono::milliseconds commitInterval; /**< Окно групповой фиксации. */
+    std::vector<OperatorCommand> recoveredCommands; /**< Команды, прочитанные при открытии. */
+    std::mutex fileMutex; /**< Защищает поля до mutex. */
+    std::FILE *file = nullptr; /**< Открытый файл журнала. */
+    std::uint64_t fileStart = 0; /**< Номер первой команды в файле. */
+    std::vector<std::uint8_t> records; /**< Копия записей файла, начиная с fileStart, для сокращения журнала. */
+    bool damaged = false; /**< Была ли ошибка записи после последней замены файла. */
+    mutable std::mutex mutex; /**< Защищает поля ниже. */
+    std::condition_variable wakeUp; /**< Сигнал о новых командах, запросе фиксации или остановке. */
+    std::condition_variable committed; /**< Сигнал о завершении фиксации. */
+    std::vector<std::uint8_t> pending; /**< Закодированные команды, ожидающие фиксации. */
+    std::uint64_t appended = 0; /**< Номер, который получит следующая команда. */
+    std::uint64_t processed = 0; /**< Номер, следующий за последней обработанной потоком записи командой. */
+    std::uint64_t commitCount = 0; /**< Количество групповых фиксаций. */
+    std::uint64_t failed = 0; /**< Количество неудачных фиксаций. */
+    bool flushRequested = false; /**< Запрошена немедленная фиксация. */
+    bool stopping = false; /**< Запрошена остановка потока. */
+    std::thread thread; /**< Поток записи. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_COMMANDJOURNAL_H
@@ -0,0 +1,86 @@
+#include "ControlCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+FleetStore::UnitId ControlCore::addUnit(int temperature, int pressure, int humidity) {
+    FleetStore::UnitId unit = fleetStore.addUnit(std::clamp(temperature, minTemperature, maxTemperature),
+                                                 std::max(pressure, minPressure),
+                                                 std::clamp(humidity, minHumidity, maxHumidity));
+    modes.resize(fleetStore.size());
+    airflow.resize(fleetStore);
+    return unit;
+}
+
+bool ControlCore::setTemperature(FleetStore::UnitId unit, int value) {
+    value = std::clamp(value, minTemperature, maxTemperature);
+    if (fleetStore.setpoint(unit) == value)
+        return false;
+    fleetStore.setSetpoint(unit, value);
+    return true;
+}
+
+bool ControlCore::togglePower(FleetStore::UnitId unit) {
+    fleetStore.setPowered(unit, !fleetStore.isPowered(unit));
+    return fleetStore.isPowered(unit);
+}
+
+bool ControlCore::setAirflow(FleetStore::UnitId unit, AirflowDirection direction) {
+    float angle = normalizeAngle(direction.angle);
+    float strength = std::clamp(direction.strength, 0.0f, 1.0f);
+    if (fleetStore.airflowAngle(unit) == angle && fleetStore.airflowStrength(unit) == strength)
+        return false;
+    fleetStore.setAirflow(unit, angle, strength);
+    return true;
+}
+
+bool ControlCore::rotateAirflow(FleetStore::UnitId unit, float degrees) {
+    return setAirflow(unit, {fleetStore.airflowAngle(unit) + degrees, fleetStore.airflowStrength(unit)});
+}
+
+bool ControlCore::changeAirflowStrength(FleetStore::UnitId unit, float delta) {
+    return setAirflow(unit, {fleetStore.airflowAngle(unit), fleetStore.airflowStrength(unit) + delta});
+}
+
+bool ControlCore::toggleAirflowSweep(FleetStore::UnitId unit) {
+    fleetStore.setAirflowSweep(unit, !fleetStore.airflowSweep(unit));
+    return fleetStore.airflowSweep(unit);
+}
+
+bool ControlCore::applySensorReading(const SensorReading &reading) {
+    if (reading.unit >= fleetStore.size())
+        return false;
+    // Ограничение выполняется до округления: lround вне диапазона int не определен.
+    int pressure = static_cast<int>(std::lround(std::clamp<double>(reading.pressure, minPressure,
+                                                                   std::numeric_limits<std::int32_t>::max())));
+    int humidity = static_cast<int>(std::lround(std::clamp<double>(reading.humidity, minHumidity, maxHumidity)));
+    bool changed = fleetStore.temperature(reading.unit) != reading.temperature ||
+                   fleetStore.pressure(reading.unit) != pressure || fleetStore.humidity(reading.unit) != humidity;
+    fleetStore.setTemperature(reading.unit, reading.temperature);
+    fleetStore.setPressure(reading.unit, pressure);
+    fleetStore.setHumidity(reading.unit, humidity);
+    return changed;
+}
+
+bool ControlCore::applyCommand(const OperatorCommand &command) {
+    if (command.unit >= fleetStore.size())
+        return false;
+    switch (command.type) {
+        case OperatorCommand::Type::SetTemperature:
+            return setTemperature(command.unit, command.value);
+        case OperatorCommand::Type::SetPower:
+            if (fleetStore.isPowered(command.unit) == (command.value != 0))
+                return false;
+            fleetStore.setPowered(command.unit, command.value != 0);
+            return true;
+        case OperatorCommand::Type::SetAirflow:
+            return setAirflow(command.unit, {command.angle, command.strength});
+        case OperatorCommand::Type::SetSweep:
+            if (fleetStore.airflowSweep(command.unit) == (command.value != 0))
+                return false;
+            fleetStore.setAirflowSweep(command.unit, command.value != 0);
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,163 @@
+#ifndef AIRCONDITIONINGCONTROL_CONTROLCORE_H
+#define AIRCONDITIONINGCONTROL_CONTROLCORE_H
+
+#include "Airflow.h"
+#include "FleetStore.h"
+#include "OperatorCommand.h"
+#include "PowerStateMachine.h"
+#include "SensorParser.h"
+
+/**
+ * @class ControlCore
+ * @brief Логика управления блоками без зависимости от Qt Widgets.
+ *
+ * Все команды оператора (уставка, питание, направление обдува) проходят
+ * через этот класс и изменяют только FleetStore. Графический интерфейс
+ * лишь отображает результат, поэтому ядро можно использовать на сервере
+ * без QApplication. Режим работы блоков (запуск, охлаждение, обогрев и т. д.)
+ * определяет PowerStateMachine по требуемому состоянию питания.
+ */
+class ControlCore {
+public:
+    static constexpr int minTemperature = 16; /**< Минимальная уставка, °C. */
+    static constexpr int maxTemperature = 30; /**< Максимальная уставка, °C. */
+    static constexpr int minHumidity = 0; /**< Минимальная влажность, %. */
+    static constexpr int maxHumidity = 100; /**< Максимальная влажность, %. */
+    static constexpr int minPressure = 0; /**< Минимальное давление, Па. */
+    static constexpr float airflowAngleStep = 15.0f; /**< Шаг поворота жалюзи, градусы. */
+    static constexpr float airflowStrengthStep = 0.1f; /**< Шаг изменения силы потока. */
+
+    /**
+     * @brief Конструктор класса ControlCore.
+     * @param fleet Хранилище состояния блоков.
+     * @param power Временные параметры переходов между режимами.
+     */
+    explicit ControlCore(FleetStore &fleet, const PowerStateConfig &power = {}) : fleetStore(fleet), modes(power) {}
+
+    /**
+     * @brief Возвращает хранилище состояния блоков.
+     * @return Хранилище состояния блоков.
+     */
+    FleetStore &fleet() { return fleetStore; }
+    const FleetStore &fleet() const { return fleetStore; }
+
+    /**
+     * @brief Добавляет блок, приводя начальные значения к допустимым диапазонам.
+     * @param temperature Начальная уставка температуры, °C.
+     * @param pressure Начальное давление, Па.
+     * @param humidity Начальная влажность, %.
+     * @return Индекс добавленного блока.
+     */
+    FleetStore::UnitId addUnit(int temperature, int pressure, int humidity);
+
+    /**
+     * @brief Задает уставку температуры блока.
+     * @param unit Индекс блока.
+     * @param value Новая уставка, °C; приводится к диапазону [minTemperature, maxTemperature].
+     * @return true, если уставка изменилась.
+     */
+    bool setTemperature(FleetStore::UnitId unit, int value);
+
+    /**
+     * @brief Переключает требуемое состояние питания блока.
+     *
+     * Режим работы меняется при следующем вызове tick().
+     *
+     * @param unit Индекс блока.
+     * @return Новое состояние питания.
+     */
+    bool togglePower(FleetStore::UnitId unit);
+
+    /**
+     * @brief Задает направление обдува блока.
+     * @param unit Индекс блока.
+     * @param direction Направление; угол приводится к [0, 360), сила — к [0, 1].
+     * @return true, если направление изменилось.
+     */
+    bool setAirflow(FleetStore::UnitId unit, AirflowDirection direction);
+
+    /**
+     * @brief Поворачивает жалюзи блока.
+     * @param unit Индекс блока.
+     * @param degrees Угол поворота, градусы; положительный — против часовой стрелки.
+     * @return true, если направление изменилось.
+     */
+    bool rotateAirflow(FleetStore::UnitId unit, float degrees);
+
+    /**
+     * @brief Изменяет силу потока блока.
+     * @param unit Индекс блока.
+     * @param delta Приращение силы потока.
+     * @return true, если сила изменилась (не уперлась в границу).
+     */
+    bool changeAirflowStrength(FleetStore::UnitId unit, float delta);
+
+    /**
+     * @brief Переключает качание жалюзи блока.
+     * @param unit Индекс блока.
+     * @return Новое состояние качания.
+     */
+    bool toggleAirflowSweep(FleetStore::UnitId unit);
+
+    /**
+     * @brief Продвигает анимацию направления обдува всех блоков.
+     * @param seconds Время, прошедшее с предыдущего вызова, с.
+     * @return Количество блоков, направление которых еще меняется.
+     */
+    std::size_t animateAirflow(float seconds) { return airflow.advance(fleetStore, seconds); }
+
+    /**
+     * @brief Возвращает отображаемое (анимированное) направление обдува блока.
+     * @param unit Индекс блока.
+     * @return Направление обдува.
+     */
+    AirflowDirection displayedAirflow(FleetStore::UnitId unit) const { return airflow.displayed(unit); }
+
+    /**
+     * @brief Записывает показания датчиков в состояние блока.
+     * @param reading Показания; давление и влажность приводятся к допустимым диапазонам.
+     * @return true, если хотя бы одно сохраненное значение изменилось.
+     */
+    bool applySensorReading(const SensorReading &reading);
+
+    /**
+     * @brief Применяет команду оператора из журнала.
+     * @param command Команда; команды для блоков вне парка пропускаются.
+     * @return true, если состояние блока изменилось.
+     */
+    bool applyCommand(const OperatorCommand &command);
+
+    /**
+     * @brief Выполняет переходы между режимами работы для всех блоков.
+     * @param now Текущее время по монотонным часам, с.
+     * @return Количество блоков, сменивших режим.
+     */
+    std::size_t tick(double now) { return modes.tick(fleetStore, now); }
+
+    /**
+     * @brief Возвращает режим работы блока.
+     * @param unit Индекс блока.
+     * @return Режим работы.
+     */
+    UnitMode mode(FleetStore::UnitId unit) const { return modes.mode(unit); }
+
+    /**
+     * @brief Проверяет, работает ли компрессор блока.
+     * @param unit Индекс блока.
+     * @return true в режимах охлаждения и обогрева.
+     */
+    bool compressorRunning(FleetStore::UnitId unit) const { return modes.compressorRunning(unit); }
+
+    /**
+     * @brief Сообщает об аварии блока.
+     * @param unit Индекс блока.
+     */
+    void reportFault(FleetStore::UnitId unit) { modes.reportFault(unit); }
+
+private:
+    FleetStore &fleetStore; /**< Хранилище состояния блоков. */
+    PowerStateMachine modes; /**< Режимы работы блоков. */
+    AirflowAnimator airflow; /**< Анимация направления обдува блоков. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_CONTROLCORE_H
@@ -0,0 +1,186 @@
+#include "FleetGridView.h"
+
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <array>
+
+/**
+ * @brief Цвета плиток по режиму работы блока (индекс — UnitMode).
+ */
+static constexpr std::array<QRgb, 6> modeColors = {
+    qRgb(128, 128, 128), /* Off */
+    qRgb(230, 200, 60), /* Starting */
+    qRgb(60, 130, 230), /* Cooling */
+    qRgb(230, 110, 50), /* Heating */
+    qRgb(90, 190, 110), /* Fan */
+    qRgb(210, 40, 160), /* Fault */
+};
+
+/**
+ * @brief Названия режимов работы для крупных плиток (индекс — UnitMode).
+ */
+static const char *const modeNames[] = {"Выключен", "Запуск", "Охлаждение", "Обогрев", "Вентиляция", "Авария"};
+
+FleetGridView::FleetGridView(const ControlCore &core, QWidget *parent) : QAbstractScrollArea(parent), core(core) {
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent);
+    connect(&refreshTimer, &QTimer::timeout, viewport(), static_cast<void (QWidget::*)()>(&QWidget::update));
+    refreshTimer.start(refreshIntervalMs);
+}
+
+int FleetGridView::columnCount() const {
+    return std::max(1, viewport()->width() / tile);
+}
+
+void FleetGridView::updateScrollBar() {
+    auto units = static_cast<qint64>(core.fleet().size());
+    qint64 rows = (units + columnCount() - 1) / columnCount();
+    qint64 height = rows * tile;
+    verticalScrollBar()->setRange(0, static_cast<int>(std::max<qint64>(0, height - viewport()->height())));
+    verticalScrollBar()->setPageStep(viewport()->height());
+    verticalScrollBar()->setSingleStep(tile);
+}
+
+void FleetGridView::selectUnit(FleetStore::UnitId unit) {
+    if (unit >= core.fleet().size())
+        return;
+    selected = unit;
+    int row = static_cast<int>(unit / static_cast<FleetStore::UnitId>(columnCount()));
+    int top = row * tile;
+    if (top < verticalScrollBar()->value() || top + tile > verticalScrollBar()->value() + viewport()->height())
+        verticalScrollBar()->setValue(top - viewport()->height() / 2);
+    viewport()->update();
+}
+
+void FleetGridView::setTileSize(int size) {
+    size = std::clamp(size, minTileSize, maxTileSize);
+    if (size == tile)
+        return;
+    // Первый видимый блок остается в верхней строке.
+    auto first = static_cast<qint64>(verticalScrollBar()->value() / tile) * columnCount();
+    tile = size;
+    updateScrollBar();
+    verticalScrollBar()->setValue(static_cast<int>(first / columnCount() * tile));
+    viewport()->update();
+}
+
+void FleetGridView::resizeEvent(QResizeEvent *event) {
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBar();
+}
+
+void FleetGridView::wheelEvent(QWheelEvent *event) {
+    if (!(event->modifiers() & Qt::ControlModifier)) {
+        QAbstractScrollArea::wheelEvent(event);
+        return;
+    }
+    // Тачпады и колеса высокого разрешения присылают доли шага в 120 единиц,
+    // поэтому остаток поворота копится между событиями.
+    wheelRemainder += event->angleDelta().y();
+    int steps = wheelRemainder / 120;
+    wheelRemainder -= steps * 120;
+    int size = tile;
+    for (; steps > 0; --steps)
+        size = std::max(size + 1, size * 5 / 4);
+    for (; steps < 0; ++steps)
+        size = std::min(size - 1, size * 4 / 5);
+    setTileSize(size);
+    event->accept();
+}
+
+void FleetGridView::mousePressEvent(QMouseEvent *event) {
+    int columns = columnCount();
+    int column = event->pos().x() / tile;
+    qint64 row = (event->pos().y() + verticalScrollBar()->value()) / tile;
+    qint64 index = row * columns + column;
+    if (column >= columns || index >= static_cast<qint64>(core.fleet().size()))
+        return;
+    selected = static_cast<FleetStore::UnitId>(index);
+    viewport()->update();
+    if (selectionHandler)
+        selectionHandler(selected);
+}
+
+void FleetGridView::paintEvent(QPaintEvent *event) {
+    QPainter painter(viewport());
+    painter.fillRect(event->rect(), palette().base());
+
+    int top = verticalScrollBar()->value();
+    int firstRow = (top + event->rect().top()) / tile;
+    int lastRow = (top + event->rect().bottom()) / tile;
+    if (tile < imageTileSize)
+        paintImage(painter, firstRow, lastRow);
+    else
+        paintTiles(painter, firstRow, lastRow);
+
+    auto columns = static_cast<FleetStore::UnitId>(columnCount());
+    QRect highlight(static_cast<int>(selected % columns) * tile,
+                    static_cast<int>(selected / columns) * tile - top, tile, tile);
+    if (highlight.intersects(event->rect())) {
+        painter.setPen(QPen(palette().highlight(), 2));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(highlight.adjusted(1, 1, -1, -1));
+    }
+}
+
+void FleetGridView::paintImage(QPainter &painter, int firstRow, int lastRow) {
+    const std::size_t units = core.fleet().size();
+    const int columns = columnCount();
+    const int rows = lastRow - firstRow + 1;
+    if (cells.width() != columns || cells.height() < rows)
+        cells = QImage(columns, std::max(rows, viewport()->height() / tile + 2), QImage::Format_RGB32);
+
+    const QRgb background = palette().base().color().rgb();
+    for (int row = 0; row < rows; ++row) {
+        auto *line = reinterpret_cast<QRgb *>(cells.scanLine(row));
+        std::size_t index = static_cast<std::size_t>(firstRow + row) * static_cast<std::size_t>(columns);
+        for (int column = 0; column < columns; ++column, ++index) {
+            line[column] = index < units
+                               ? modeColors[static_cast<std::size_t>(core.mode(static_cast<FleetStore::UnitId>(index)))]
+                               : background;
+        }
+    }
+    QRect target(0, firstRow * tile - verticalScrollBar()->value(), columns * tile, rows * tile);
+    painter.drawImage(target, cells, QRect(0, 0, columns, rows));
+}
+
+void FleetGridView::paintTiles(QPainter &painter, int firstRow, int lastRow) {
+    const FleetStore &fleet = core.fleet();
+    const std::size_t units = fleet.size();
+    const int columns = columnCount();
+    const int top = verticalScrollBar()->value();
+    const int gap = tile >= 16 ? 2 : 1;
+    const bool numbered = tile >= 24;
+    const bool detailed = tile >= detailedTileSize;
+
+    QFont font = painter.font();
+    font.setPixelSize(std::max(8, tile / (detailed ? 6 : 3)));
+    painter.setFont(font);
+    painter.setPen(Qt::black);
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        std::size_t index = static_cast<std::size_t>(row) * static_cast<std::size_t>(columns);
+        for (int column = 0; column < columns && index < units; ++column, ++index) {
+            auto unit = static_cast<FleetStore::UnitId>(index);
+            auto mode = static_cast<std::size_t>(core.mode(unit));
+            QRect cell(column * tile, row * tile - top, tile - gap, tile - gap);
+            painter.fillRect(cell, QColor::fromRgb(modeColors[mode]));
+            if (!numbered)
+                continue;
+            if (!detailed) {
+                painter.drawText(cell, Qt::AlignCenter, QString::number(index + 1));
+                continue;
+            }
+            QString text = QString("%1\n%2 °C\n%3")
+                               .arg(index + 1)
+                               .arg(static_cast<double>(fleet.temperature(unit)), 0, 'f', 1)
+                               .arg(QString::fromUtf8(modeNames[mode]));
+            painter.drawText(cell.adjusted(2, 2, -2, -2), Qt::AlignCenter, text);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef AIRCONDITIONINGCONTROL_FLEETGRIDVIEW_H
+#define AIRCONDITIONINGCONTROL_FLEETGRIDVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QImage>
+#include <QTimer>
+
+#include <functional>
+
+#include "ControlCore.h"
+
+/**
+ * @class FleetGridView
+ * @brief Обзор парка: сетка плиток блоков, нарисованная одним paintEvent.
+ *
+ * Виджет не создает объектов на каждый блок: плитки вычисляются из
+ * индекса блока, и paintEvent рисует только строки, попавшие в
+ * перерисовываемую область, поэтому стоимость кадра зависит от размера
+ * окна, а не от размера парка. Детализация зависит от размера плитки:
+ * мелкие плитки выводятся одним изображением, где каждому блоку
+ * соответствует пиксель цвета режима; средние — закрашенными
+ * прямоугольниками с номером блока; крупные — дополнительно с
+ * температурой и названием режима. Размер плитки меняется колесом мыши
+ * с нажатой Ctrl.
+ */
+class FleetGridView : public QAbstractScrollArea {
+public:
+    static constexpr int minTileSize = 2; /**< Наименьший размер плитки, пикселей. */
+    static constexpr int maxTileSize = 128; /**< Наибольший размер плитки, пикселей. */
+    static constexpr int imageTileSize = 8; /**< Плитки меньше этого размера выводятся одним изображением. */
+    static constexpr int detailedTileSize = 64; /**< Плитки от этого размера выводятся с подробностями. */
+    static constexpr int refreshIntervalMs = 100; /**< Период перерисовки видимых плиток. */
+
+    /**
+     * @brief Конструктор класса FleetGridView.
+     * @param core Ядро управления блоками.
+     * @param parent Указатель на родительский виджет.
+     */
+    explicit FleetGridView(const ControlCore &core, QWidget *parent = nullptr);
+
+    /**
+     * @brief Задает обработчик выбора блока щелчком по плитке.
+     * @param handler Обработчик; получает индекс выбранного блока.
+     */
+    void setSelectionHandler(std::function<void(FleetStore::UnitId)> handler) {
+        selectionHandler = std::move(handler);
+    }
+
+    /**
+     * @brief Выделяет блок и прокручивает сетку к нему.
+     * @param unit Индекс блока.
+     */
+    void selectUnit(FleetStore::UnitId unit);
+
+    /**
+     * @brief Задает размер плитки.
+     * @param size Размер плитки, пикселей; приводится к [minTileSize, maxTileSize].
+     */
+    void setTileSize(int size);
+
+    /**
+     * @brief Возвращает размер плитки.
+     * @return Размер плитки, пикселей.
+     */
+    int tileSize() const { return tile; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+
+private:
+    /**
+     * @brief Возвращает количество плиток в строке.
+     * @return Количество столбцов сетки.
+     */
+    int columnCount() const;
+
+    /**
+     * @brief Пересчитывает диапазон полосы прокрутки по размеру парка и окна.
+     */
+    void updateScrollBar();
+
+    /**
+     * @brief Рисует видимые строки мелких плиток одним изображением.
+     * @param painter Рисовальщик области просмотра.
+     * @param firstRow Первая видимая строка.
+     * @param lastRow Последняя видимая строка.
+     */
+    void paintImage(QPainter &painter, int firstRow, int lastRow);
+
+    /**
+     * @brief Рисует видимые плитки по отдельности.
+     * @param painter Рисовальщик области просмотра.
+     * @param firstRow Первая видимая строка.
+     * @param lastRow Последняя видимая строка.
+     */
+    void paintTiles(QPainter &painter, int firstRow, int lastRow);
+
+    const ControlCore &core; /**< Ядро управления блоками. */
+    int tile = 24; /**< Размер плитки, пикселей. */
+    int wheelRemainder = 0; /**< Накопленный поворот колеса меньше одного шага, 1/8 градуса. */
+    FleetStore::UnitId selected = 0; /**< Выделенный блок. */
+    std::function<void(FleetStore::UnitId)> selectionHandler; /**< Обработчик выбора блока. */
+    QImage cells; /**< Изображение мелких плиток, по пикселю на блок. */
+    QTimer refreshTimer; /**< Таймер перерисовки видимых плиток. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_FLEETGRIDVIEW_H
@@ -0,0 +1,29 @@
+#include "FleetStore.h"
+
+FleetStore::FleetStore(std::size_t capacity) {
+    reserve(capacity);
+}
+
+FleetStore::UnitId FleetStore::addUnit(int setpoint, int pressure, int humidity) {
+    auto unit = static_cast<UnitId>(setpointColumn.size());
+    setpointColumn.push_back(static_cast<std::int16_t>(setpoint));
+    temperatureColumn.push_back(static_cast<float>(setpoint));
+    pressureColumn.push_back(pressure);
+    humidityColumn.push_back(static_cast<std::uint8_t>(humidity));
+    powerColumn.push_back(0);
+    airflowAngleColumn.push_back(0.0f);
+    airflowStrengthColumn.push_back(0.0f);
+    airflowSweepColumn.push_back(0);
+    return unit;
+}
+
+void FleetStore::reserve(std::size_t capacity) {
+    setpointColumn.reserve(capacity);
+    temperatureColumn.reserve(capacity);
+    pressureColumn.reserve(capacity);
+    humidityColumn.reserve(capacity);
+    powerColumn.reserve(capacity);
+    airflowAngleColumn.reserve(capacity);
+    airflowStrengthColumn.reserve(capacity);
+    airflowSweepColumn.reserve(capacity);
+}
@@ -0,0 +1,62 @@
+#include "FrameTimedView.h"
+
+#include <QOpenGLWidget>
+#include <QPainter>
+
+#include <algorithm>
+
+#include "TraceRecorder.h"
+
+static const QRect overlayRect(4, 2, 160, 16); /**< Область подписи частоты и времени кадра. */
+
+FrameTimedView::FrameTimedView(QGraphicsScene *scene, QWidget *parent) : QGraphicsView(scene, parent) {
+    connect(&statisticsTimer, &QTimer::timeout, this, &FrameTimedView::updateStatistics);
+    statisticsTimer.start(1000);
+    interval.start();
+}
+
+void FrameTimedView::applyRenderSettings(const RenderSettings &settings) {
+    if (settings.backend != backend) {
+        backend = settings.backend;
+        if (backend == RenderSettings::Backend::OpenGl)
+            setViewport(new QOpenGLWidget);
+        else
+            setViewport(new QWidget);
+    }
+    setViewportUpdateMode(settings.updateMode);
+    setCacheMode(settings.cacheStatic ? CacheBackground : CacheNone);
+    overlay = settings.frameOverlay;
+    viewport()->update();
+}
+
+void FrameTimedView::paintEvent(QPaintEvent *event) {
+    TraceScope trace(traceName, "paint");
+    QElapsedTimer frame;
+    frame.start();
+    QGraphicsView::paintEvent(event);
+    intervalNs += frame.nsecsElapsed();
+    ++intervalFrames;
+}
+
+void FrameTimedView::updateStatistics() {
+    qint64 elapsed = std::max<qint64>(1, interval.restart());
+    fps = static_cast<double>(intervalFrames) * 1000.0 / static_cast<double>(elapsed);
+    frameMs = intervalFrames > 0 ? static_cast<double>(intervalNs) / 1e6 / static_cast<double>(intervalFrames) : 0.0;
+    intervalFrames = 0;
+    intervalNs = 0;
+    // При минимальном обновлении подпись иначе перерисовывалась бы лишь при изменениях рядом с ней.
+    if (overlay)
+        viewport()->update(overlayRect);
+}
+
+void FrameTimedView::drawForeground(QPainter *painter, const QRectF &rect) {
+    QGraphicsView::drawForeground(painter, rect);
+    if (!overlay)
+        return;
+    painter->save();
+    painter->resetTransform();
+    painter->setPen(palette().color(QPalette::Text));
+    painter->drawText(overlayRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      QString("%1 кадр/с, %2 мс").arg(fps, 0, 'f', 0).arg(frameMs, 0, 'f', 2));
+    painter->restore();
+}
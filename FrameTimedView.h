@@ -0,0 +1,94 @@
+#ifndef AIRCONDITIONINGCONTROL_FRAMETIMEDVIEW_H
+#define AIRCONDITIONINGCONTROL_FRAMETIMEDVIEW_H
+
+#include <QElapsedTimer>
+#include <QGraphicsView>
+#include <QTimer>
+
+/**
+ * @struct RenderSettings
+ * @brief Параметры отрисовки графических представлений.
+ */
+struct RenderSettings {
+    /**
+     * @brief Способ отрисовки области просмотра.
+     */
+    enum class Backend {
+        Raster, /**< Программная отрисовка QWidget (по умолчанию). */
+        OpenGl /**< Отрисовка через QOpenGLWidget. */
+    };
+
+    Backend backend = Backend::Raster; /**< Способ отрисовки области просмотра. */
+    QGraphicsView::ViewportUpdateMode updateMode = QGraphicsView::MinimalViewportUpdate; /**< Режим обновления. */
+    bool cacheStatic = false; /**< Кэшировать фон и неизменные элементы сцены. */
+    bool frameOverlay = false; /**< Показывать частоту и время кадра поверх сцены. */
+};
+
+/**
+ * @class FrameTimedView
+ * @brief Графическое представление с измерением времени кадра.
+ *
+ * Каждый вызов paintEvent измеряется и при включенной записи трассы
+ * попадает в TraceRecorder; раз в секунду по таймеру обновляются
+ * частота кадров и среднее время кадра. Если включен вывод поверх сцены, они
+ * рисуются в drawForeground в левом верхнем углу области просмотра, что
+ * позволяет сравнивать способы отрисовки на одном и том же окне.
+ */
+class FrameTimedView : public QGraphicsView {
+public:
+    /**
+     * @brief Конструктор класса FrameTimedView.
+     * @param scene Отображаемая сцена.
+     * @param parent Указатель на родительский виджет.
+     */
+    explicit FrameTimedView(QGraphicsScene *scene, QWidget *parent = nullptr);
+
+    /**
+     * @brief Применяет параметры отрисовки.
+     *
+     * При смене способа отрисовки область просмотра пересоздается.
+     *
+     * @param settings Параметры отрисовки.
+     */
+    void applyRenderSettings(const RenderSettings &settings);
+
+    /**
+     * @brief Возвращает частоту кадров за последнюю секунду.
+     * @return Количество кадров в секунду.
+     */
+    double framesPerSecond() const { return fps; }
+
+    /**
+     * @brief Возвращает среднее время кадра за последнюю секунду.
+     * @return Время кадра, мс.
+     */
+    double frameTimeMs() const { return frameMs; }
+
+    /**
+     * @brief Задает имя событий отрисовки в трассе TraceRecorder.
+     * @param name Имя события; строковый литерал.
+     */
+    void setTraceName(const char *name) { traceName = name; }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void drawForeground(QPainter *painter, const QRectF &rect) override;
+
+private:
+    /**
+     * @brief Завершает интервал измерения и обновляет частоту и время кадра.
+     */
+    void updateStatistics();
+
+    RenderSettings::Backend backend = RenderSettings::Backend::Raster; /**< Текущий способ отрисовки. */
+    bool overlay = false; /**< Показывать ли частоту и время кадра. */
+    const char *traceName = "paint"; /**< Имя событий отрисовки в трассе. */
+    QElapsedTimer interval; /**< Время с начала текущего интервала измерения. */
+    QTimer statisticsTimer; /**< Таймер завершения интервала измерения. */
+    qint64 intervalFrames = 0; /**< Кадров в текущем интервале. */
+    qint64 intervalNs = 0; /**< Суммарное время кадров в текущем интервале, нс. */
+    double fps = 0; /**< Частота кадров за последний интервал. */
+    double frameMs = 0; /**< Среднее время кадра за последний интервал, мс. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_FRAMETIMEDVIEW_H
@@ -0,0 +1,254 @@
+#include "Instrumentation.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::array<const char *, Instrumentation::ProbeCount> probeNames = {
+    "updateTemperature", "updateTemperatureUnits", "updatePressureUnits", "togglePower", "toggleTheme",
+    "themeStep", "airflowCommand", "airflowFrame", "flushUpdates", "modeTick", "sensorDrain", "thermostatSync",
+    "recordSample", "refreshTrends", "settingsEncode", "settingsCommit", "settingsLoad", "xmlSave", "xmlLoad",
+    "journalCommit",
+};
+
+constexpr std::array<const char *, Instrumentation::CounterCount> counterNames = {
+    "sensorReadings", "sceneUpdates", "skippedUpdates", "settingsWrites", "settingsWriteFailures",
+};
+
+/**
+ * @brief Замеры и счетчики одного потока.
+ */
+struct ThreadStats {
+    const char *name = nullptr; /**< Имя потока в отчете. */
+    std::size_t index = 0; /**< Порядковый номер потока. */
+    std::array<LatencyHistogram, Instrumentation::ProbeCount> probes; /**< Гистограммы участков. */
+    std::array<std::atomic<std::uint64_t>, Instrumentation::CounterCount> counters{}; /**< Счетчики. */
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadStats>> registry; // Наборы не удаляются: отчет переживает завершение потоков.
+thread_local ThreadStats *current = nullptr;
+thread_local const char *pendingName = nullptr;
+
+ThreadStats &localStats() {
+    if (!current) {
+        auto stats = std::make_unique<ThreadStats>();
+        std::lock_guard lock(registryMutex);
+        stats->index = registry.size();
+        stats->name = pendingName;
+        current = stats.get();
+        registry.push_back(std::move(stats));
+    }
+    return *current;
+}
+
+// Отметка выполняемого участка: номер участка + 1 в старших 8 битах и время входа в младших 56 битах
+// (нс от handlerOrigin, около двух лет), чтобы сторожевой поток читал ее одной атомарной загрузкой.
+constexpr unsigned handlerTimeBits = 56;
+constexpr std::uint64_t handlerTimeMask = (std::uint64_t{1} << handlerTimeBits) - 1;
+std::atomic<std::uint64_t> handlerMark{0};
+std::chrono::steady_clock::time_point handlerOrigin;
+std::atomic<std::thread::id> watchedThread{};
+
+// Поток-владелец единственный писатель, поэтому обычных load/store достаточно.
+void bump(std::atomic<std::uint64_t> &value, std::uint64_t amount) {
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace
+
+std::atomic<bool> Instrumentation::enabledFlag{false};
+std::atomic<bool> Instrumentation::trackingFlag{false};
+
+std::size_t LatencyHistogram::bucketIndex(std::uint64_t ns) noexcept {
+    ns = std::min<std::uint64_t>(ns, (std::uint64_t{2} << maxExponent) - 1);
+    if (ns < subBucketCount)
+        return static_cast<std::size_t>(ns);
+    unsigned exponent = static_cast<unsigned>(std::bit_width(ns)) - 1;
+    unsigned shift = exponent - subBucketBits;
+    return static_cast<std::size_t>(subBucketCount + shift * subBucketCount + ((ns >> shift) - subBucketCount));
+}
+
+std::uint64_t LatencyHistogram::bucketValue(std::size_t index) noexcept {
+    if (index < subBucketCount)
+        return index;
+    std::uint64_t shift = (index - subBucketCount) / subBucketCount;
+    std::uint64_t sub = (index - subBucketCount) % subBucketCount;
+    std::uint64_t low = (subBucketCount + sub) << shift;
+    return low + ((std::uint64_t{1} << shift) >> 1);
+}
+
+void LatencyHistogram::record(std::uint64_t ns) noexcept {
+    bump(buckets[bucketIndex(ns)], 1);
+    bump(totalNs, ns);
+    if (ns > maxNs.load(std::memory_order_relaxed))
+        maxNs.store(ns, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::mergeInto(std::array<std::uint64_t, bucketCount> &counts, std::uint64_t &total,
+                                 std::uint64_t &max) const {
+    for (std::size_t i = 0; i < bucketCount; ++i)
+        counts[i] += buckets[i].load(std::memory_order_relaxed);
+    total += totalNs.load(std::memory_order_relaxed);
+    max = std::max(max, maxNs.load(std::memory_order_relaxed));
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize(const std::array<std::uint64_t, bucketCount> &counts,
+                                                      std::uint64_t total, std::uint64_t max) {
+    Summary summary;
+    summary.totalNs = total;
+    summary.maxNs = max;
+    for (auto count: counts)
+        summary.count += count;
+    if (summary.count == 0)
+        return summary;
+
+    auto percentile = [&](double fraction) {
+        auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(summary.count - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(bucketValue(i), max);
+        }
+        return max;
+    };
+    summary.p50Ns = percentile(0.50);
+    summary.p90Ns = percentile(0.90);
+    summary.p99Ns = percentile(0.99);
+    return summary;
+}
+
+void Instrumentation::setThreadName(const char *name) {
+    TraceRecorder::setThreadName(name);
+    pendingName = name;
+    if (current) {
+        std::lock_guard lock(registryMutex);
+        current->name = name;
+    }
+}
+
+void Instrumentation::record(Probe probe, std::uint64_t ns) {
+    localStats().probes[probe].record(ns);
+}
+
+void Instrumentation::add(Counter counter, std::uint64_t amount) {
+    bump(localStats().counters[counter], amount);
+}
+
+LatencyHistogram::Summary Instrumentation::summary(Probe probe) {
+    std::array<std::uint64_t, LatencyHistogram::bucketCount> counts{};
+    std::uint64_t total = 0;
+    std::uint64_t max = 0;
+    std::lock_guard lock(registryMutex);
+    for (const auto &stats: registry)
+        stats->probes[probe].mergeInto(counts, total, max);
+    return LatencyHistogram::summarize(counts, total, max);
+}
+
+std::uint64_t Instrumentation::total(Counter counter) {
+    std::uint64_t sum = 0;
+    std::lock_guard lock(registryMutex);
+    for (const auto &stats: registry)
+        sum += stats->counters[counter].load(std::memory_order_relaxed);
+    return sum;
+}
+
+std::string Instrumentation::report() {
+    std::string text;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-24s %9s %10s %10s %10s %10s %12s\n", "probe", "count", "p50 us", "p90 us",
+                  "p99 us", "max us", "total ms");
+    text += line;
+    for (int probe = 0; probe < ProbeCount; ++probe) {
+        auto stats = summary(static_cast<Probe>(probe));
+        if (stats.count == 0)
+            continue;
+        std::snprintf(line, sizeof(line), "%-24s %9llu %10.1f %10.1f %10.1f %10.1f %12.1f\n",
+                      name(static_cast<Probe>(probe)), static_cast<unsigned long long>(stats.count),
+                      static_cast<double>(stats.p50Ns) / 1e3, static_cast<double>(stats.p90Ns) / 1e3,
+                      static_cast<double>(stats.p99Ns) / 1e3, static_cast<double>(stats.maxNs) / 1e3,
+                      static_cast<double>(stats.totalNs) / 1e6);
+        text += line;
+    }
+
+    std::lock_guard lock(registryMutex);
+    for (const auto &stats: registry) {
+        std::string counters;
+        for (int counter = 0; counter < CounterCount; ++counter) {
+            auto value = stats->counters[counter].load(std::memory_order_relaxed);
+            if (value == 0)
+                continue;
+            std::snprintf(line, sizeof(line), " %s=%llu", name(static_cast<Counter>(counter)),
+                          static_cast<unsigned long long>(value));
+            counters += line;
+        }
+        if (counters.empty())
+            continue;
+        if (stats->name)
+            std::snprintf(line, sizeof(line), "thread %s:", stats->name);
+        else
+            std::snprintf(line, sizeof(line), "thread #%zu:", stats->index);
+        text += line;
+        text += counters;
+        text += '\n';
+    }
+    return text;
+}
+
+bool Instrumentation::dump(const std::string &path) {
+    std::ofstream file(path, std::ios::trunc);
+    file << report();
+    return static_cast<bool>(file);
+}
+
+const char *Instrumentation::name(Probe probe) noexcept {
+    return probe < ProbeCount ? probeNames[probe] : "?";
+}
+
+const char *Instrumentation::name(Counter counter) noexcept {
+    return counter < CounterCount ? counterNames[counter] : "?";
+}
+
+void Instrumentation::watchCurrentThread() {
+    handlerOrigin = std::chrono::steady_clock::now();
+    handlerMark.store(0, std::memory_order_relaxed);
+    watchedThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+    trackingFlag.store(true, std::memory_order_release);
+}
+
+void Instrumentation::stopWatching() noexcept {
+    trackingFlag.store(false, std::memory_order_relaxed);
+    watchedThread.store(std::thread::id(), std::memory_order_relaxed);
+}
+
+std::uint64_t Instrumentation::enterHandler(Probe probe) noexcept {
+    if (watchedThread.load(std::memory_order_relaxed) != std::this_thread::get_id())
+        return untracked;
+    auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - handlerOrigin).count());
+    std::uint64_t previous = handlerMark.load(std::memory_order_relaxed);
+    handlerMark.store((static_cast<std::uint64_t>(probe) + 1) << handlerTimeBits | (ns & handlerTimeMask),
+                      std::memory_order_relaxed);
+    return previous;
+}
+
+void Instrumentation::leaveHandler(std::uint64_t previous) noexcept {
+    handlerMark.store(previous, std::memory_order_relaxed);
+}
+
+bool Instrumentation::activeHandler(Probe &probe, std::chrono::steady_clock::time_point &since) noexcept {
+    std::uint64_t mark = handlerMark.load(std::memory_order_relaxed);
+    if (mark == 0)
+        return false;
+    probe = static_cast<Probe>((mark >> handlerTimeBits) - 1);
+    since = handlerOrigin + std::chrono::nanoseconds(mark & handlerTimeMask);
+    return true;
+}
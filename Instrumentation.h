@@ -0,0 +1,308 @@
+#ifndef AIRCONDITIONINGCONTROL_INSTRUMENTATION_H
+#define AIRCONDITIONINGCONTROL_INSTRUMENTATION_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "TraceRecorder.h"
+
+/**
+ * @class LatencyHistogram
+ * @brief Гистограмма длительностей с логарифмически-линейными корзинами.
+ *
+ * Как в HdrHistogram, каждая степень двойки делится на subBucketCount
+ * равных корзин, поэтому относительная погрешность квантилей не превышает
+ * 1/subBucketCount (около 6 %) во всем диапазоне от 1 нс до 2^40 нс (~18 минут).
+ * Пишет в гистограмму один поток; читать ее можно из любого потока без
+ * блокировок — счетчики атомарны и обновляются без read-modify-write.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned subBucketBits = 4; /**< log2 количества корзин на степень двойки. */
+    static constexpr std::uint64_t subBucketCount = 1u << subBucketBits; /**< Корзин на степень двойки. */
+    static constexpr unsigned maxExponent = 40; /**< Старшая степень двойки диапазона, нс. */
+    static constexpr std::size_t bucketCount =
+        subBucketCount + (maxExponent - subBucketBits + 1) * subBucketCount; /**< Количество корзин. */
+
+    /**
+     * @brief Сводка распределения длительностей.
+     */
+    struct Summary {
+        std::uint64_t count = 0; /**< Количество замеров. */
+        std::uint64_t totalNs = 0; /**< Суммарная длительность, нс. */
+        std::uint64_t p50Ns = 0; /**< Медиана, нс. */
+        std::uint64_t p90Ns = 0; /**< 90-й процентиль, нс. */
+        std::uint64_t p99Ns = 0; /**< 99-й процентиль, нс. */
+        std::uint64_t maxNs = 0; /**< Максимум, нс. */
+    };
+
+    /**
+     * @brief Добавляет замер. Вызывается только из потока-владельца.
+     * @param ns Длительность, нс.
+     */
+    void record(std::uint64_t ns) noexcept;
+
+    /**
+     * @brief Прибавляет корзины гистограммы к накопителю при объединении потоков.
+     * @param counts Накопитель корзин.
+     * @param total Накопитель суммарной длительности, нс.
+     * @param max Накопитель максимума, нс.
+     */
+    void mergeInto(std::array<std::uint64_t, bucketCount> &counts, std::uint64_t &total, std::uint64_t &max) const;
+
+    /**
+     * @brief Строит сводку по накопленным корзинам.
+     * @param counts Корзины.
+     * @param total Суммарная длительность, нс.
+     * @param max Максимум, нс.
+     * @return Сводка распределения.
+     */
+    static Summary summarize(const std::array<std::uint64_t, bucketCount> &counts, std::uint64_t total,
+                             std::uint64_t max);
+
+    /**
+     * @brief Возвращает индекс корзины для длительности.
+     * @param ns Длительность, нс.
+     * @return Индекс корзины.
+     */
+    static std::size_t bucketIndex(std::uint64_t ns) noexcept;
+
+    /**
+     * @brief Возвращает середину корзины.
+     * @param index Индекс корзины.
+     * @return Представительная длительность корзины, нс.
+     */
+    static std::uint64_t bucketValue(std::size_t index) noexcept;
+
+private:
+    std::array<std::atomic<std::uint64_t>, bucketCount> buckets{}; /**< Количество замеров в корзинах. */
+    std::atomic<std::uint64_t> totalNs{0}; /**< Суммарная длительность, нс. */
+    std::atomic<std::uint64_t> maxNs{0}; /**< Максимальная длительность, нс. */
+};
+
+/**
+ * @class Instrumentation
+ * @brief Замеры длительности обработчиков и операций ввода-вывода и счетчики горячих путей.
+ *
+ * Каждый поток пишет в собственный набор гистограмм и счетчиков, созданный при
+ * первом замере, поэтому потоки не конкурируют за кэш-линии и блокировки.
+ * Отчет собирается объединением наборов всех потоков. Пока сбор выключен,
+ * замер сводится к чтению одного атомарного флага без обращения к часам.
+ */
+class Instrumentation {
+public:
+    /**
+     * @brief Измеряемые участки.
+     */
+    enum Probe : std::uint8_t {
+        UpdateTemperature,
+        UpdateTemperatureUnits,
+        UpdatePressureUnits,
+        TogglePower,
+        ToggleTheme,
+        ThemeStep,
+        AirflowCommand,
+        AirflowFrame,
+        FlushUpdates,
+        ModeTick,
+        SensorDrain,
+        ThermostatSync,
+        RecordSample,
+        RefreshTrends,
+        SettingsEncode,
+        SettingsCommit,
+        SettingsLoad,
+        XmlSave,
+        XmlLoad,
+        JournalCommit,
+        ProbeCount
+    };
+
+    /**
+     * @brief Счетчики горячих путей.
+     */
+    enum Counter : std::uint8_t {
+        SensorReadings, /**< Показаний датчиков применено к блокам. */
+        SceneUpdates, /**< Частей отображения перерисовано. */
+        SkippedUpdates, /**< Обновлений отображения пропущено без изменений. */
+        SettingsWrites, /**< Образов настроек записано на диск. */
+        SettingsWriteFailures, /**< Неудачных записей настроек. */
+        CounterCount
+    };
+
+    /**
+     * @brief Включает или выключает сбор замеров.
+     * @param value Включен ли сбор.
+     */
+    static void setEnabled(bool value) noexcept { enabledFlag.store(value, std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает, включен ли сбор замеров.
+     * @return true, если сбор включен.
+     */
+    static bool enabled() noexcept { return enabledFlag.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Задает имя текущего потока в отчете и в трассе TraceRecorder.
+     * @param name Имя потока; строка должна существовать до конца программы.
+     */
+    static void setThreadName(const char *name);
+
+    /**
+     * @brief Добавляет замер длительности участка в набор текущего потока.
+     * @param probe Участок.
+     * @param ns Длительность, нс.
+     */
+    static void record(Probe probe, std::uint64_t ns);
+
+    /**
+     * @brief Увеличивает счетчик текущего потока, если сбор включен.
+     * @param counter Счетчик.
+     * @param amount Приращение.
+     */
+    static void count(Counter counter, std::uint64_t amount = 1) {
+        if (enabled())
+            add(counter, amount);
+    }
+
+    /**
+     * @brief Возвращает сводку по участку, объединенную по всем потокам.
+     * @param probe Участок.
+     * @return Сводка распределения.
+     */
+    static LatencyHistogram::Summary summary(Probe probe);
+
+    /**
+     * @brief Возвращает сумму счетчика по всем потокам.
+     * @param counter Счетчик.
+     * @return Значение счетчика.
+     */
+    static std::uint64_t total(Counter counter);
+
+    /**
+     * @brief Формирует текстовый отчет: таблицу участков и счетчики по потокам.
+     * @return Текст отчета.
+     */
+    static std::string report();
+
+    /**
+     * @brief Записывает текстовый отчет в файл.
+     * @param path Путь к файлу.
+     * @return true, если файл записан.
+     */
+    static bool dump(const std::string &path);
+
+    /**
+     * @brief Возвращает имя участка.
+     * @param probe Участок.
+     * @return Имя участка.
+     */
+    static const char *name(Probe probe) noexcept;
+
+    /**
+     * @brief Возвращает имя счетчика.
+     * @param counter Счетчик.
+     * @return Имя счетчика.
+     */
+    static const char *name(Counter counter) noexcept;
+
+    static constexpr std::uint64_t untracked = UINT64_MAX; /**< Метка входа в обработчик вне отслеживаемого потока. */
+
+    /**
+     * @brief Включает отслеживание выполняемого обработчика в текущем потоке.
+     *
+     * Отслеживается один поток: участок, выполняемый в нем, и время входа в
+     * участок доступны из других потоков через activeHandler().
+     */
+    static void watchCurrentThread();
+
+    /**
+     * @brief Выключает отслеживание выполняемого обработчика.
+     */
+    static void stopWatching() noexcept;
+
+    /**
+     * @brief Возвращает, включено ли отслеживание выполняемого обработчика.
+     * @return true, если отслеживание включено.
+     */
+    static bool tracksHandlers() noexcept { return trackingFlag.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Отмечает вход в участок, если текущий поток отслеживается.
+     * @param probe Участок.
+     * @return Предыдущая отметка для leaveHandler() или untracked.
+     */
+    static std::uint64_t enterHandler(Probe probe) noexcept;
+
+    /**
+     * @brief Восстанавливает отметку, действовавшую до входа в участок.
+     * @param previous Значение, возвращенное enterHandler().
+     */
+    static void leaveHandler(std::uint64_t previous) noexcept;
+
+    /**
+     * @brief Возвращает участок, выполняемый в отслеживаемом потоке.
+     * @param probe Выполняемый участок.
+     * @param since Время входа в участок.
+     * @return false, если поток сейчас не выполняет ни одного участка.
+     */
+    static bool activeHandler(Probe &probe, std::chrono::steady_clock::time_point &since) noexcept;
+
+private:
+    static void add(Counter counter, std::uint64_t amount);
+
+    static std::atomic<bool> enabledFlag; /**< Включен ли сбор замеров. */
+    static std::atomic<bool> trackingFlag; /**< Включено ли отслеживание выполняемого обработчика. */
+};
+
+/**
+ * @class ScopedLatency
+ * @brief Замеряет длительность области видимости и добавляет ее в Instrumentation.
+ *
+ * Если включена запись трассы, область записывается еще и как событие
+ * TraceRecorder с именем участка, а при отслеживании обработчиков вход в
+ * участок отмечается для StallWatchdog. Если в момент входа все это
+ * выключено, часы не читаются и замер не записывается.
+ */
+class ScopedLatency {
+public:
+    /**
+     * @brief Конструктор класса ScopedLatency.
+     * @param probe Участок.
+     */
+    explicit ScopedLatency(Instrumentation::Probe probe) noexcept
+        : probe(probe), active(Instrumentation::enabled() || TraceRecorder::enabled()) {
+        if (active)
+            start = std::chrono::steady_clock::now();
+        if (Instrumentation::tracksHandlers())
+            previousHandler = Instrumentation::enterHandler(probe);
+    }
+
+    ~ScopedLatency() {
+        if (previousHandler != Instrumentation::untracked)
+            Instrumentation::leaveHandler(previousHandler);
+        if (!active)
+            return;
+        auto end = std::chrono::steady_clock::now();
+        if (Instrumentation::enabled())
+            Instrumentation::record(probe, static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+        if (TraceRecorder::enabled())
+            TraceRecorder::complete(Instrumentation::name(probe), "handler", start, end);
+    }
+
+    ScopedLatency(const ScopedLatency &) = delete;
+    ScopedLatency &operator=(const ScopedLatency &) = delete;
+
+private:
+    Instrumentation::Probe probe; /**< Участок. */
+    bool active; /**< Был ли сбор включен при входе. */
+    std::uint64_t previousHandler = Instrumentation::untracked; /**< Отметка выполняемого участка до входа. */
+    std::chrono::steady_clock::time_point start; /**< Время входа. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_INSTRUMENTATION_H
@@ -0,0 +1,36 @@
+#ifndef AIRCONDITIONINGCONTROL_OPERATORCOMMAND_H
+#define AIRCONDITIONINGCONTROL_OPERATORCOMMAND_H
+
+#include <cstdint>
+
+#include "FleetStore.h"
+
+/**
+ * @struct OperatorCommand
+ * @brief Команда оператора в журнале.
+ *
+ * Команда хранит итоговое значение, а не приращение (например, «питание
+ * включено», а не «переключить питание»), поэтому повторное применение
+ * журнала поверх любого более старого снимка настроек дает одно и то же
+ * состояние.
+ */
+struct OperatorCommand {
+    /**
+     * @brief Вид команды.
+     */
+    enum class Type : std::uint8_t {
+        SetTemperature = 1, /**< Уставка температуры: value, °C. */
+        SetPower = 2, /**< Питание: value (0 — выключено). */
+        SetAirflow = 3, /**< Направление обдува: angle, strength. */
+        SetSweep = 4 /**< Качание жалюзи: value (0 — выключено). */
+    };
+
+    Type type = Type::SetTemperature; /**< Вид команды. */
+    FleetStore::UnitId unit = 0; /**< Индекс блока. */
+    std::int64_t timestampMs = 0; /**< Время команды, мс от начала эпохи. */
+    std::int32_t value = 0; /**< Целое значение команды. */
+    float angle = 0; /**< Угол направления обдува, градусы. */
+    float strength = 0; /**< Сила потока обдува, [0, 1]. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_OPERATORCOMMAND_H
@@ -0,0 +1,76 @@
+#include "PowerStateMachine.h"
+
+#include <limits>
+
+PowerStateMachine::PowerStateMachine(const PowerStateConfig &config) : config(config) {
+}
+
+void PowerStateMachine::resize(std::size_t units) {
+    modeColumn.resize(units, static_cast<std::uint8_t>(UnitMode::Off));
+    faultColumn.resize(units, 0);
+    enteredColumn.resize(units, 0.0);
+    compressorStopColumn.resize(units, -std::numeric_limits<double>::infinity());
+}
+
+std::size_t PowerStateMachine::tick(const FleetStore &fleet, double now) {
+    if (modeColumn.size() != fleet.size())
+        resize(fleet.size());
+
+    const std::size_t count = fleet.size();
+    std::span<const std::int16_t> setpoints = fleet.setpoints();
+    std::span<const float> temperatures = fleet.temperatures();
+    std::span<const std::uint8_t> power = fleet.powerStates();
+    std::size_t transitions = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto current = static_cast<UnitMode>(modeColumn[i]);
+        const bool compressor = current == UnitMode::Cooling || current == UnitMode::Heating;
+        // Положительная ошибка — в помещении теплее уставки.
+        const float error = temperatures[i] - static_cast<float>(setpoints[i]);
+        UnitMode next = current;
+
+        if (faultColumn[i]) {
+            next = UnitMode::Fault;
+            faultColumn[i] = 0;
+        } else if (!power[i]) {
+            next = UnitMode::Off;
+        } else {
+            switch (current) {
+                case UnitMode::Off:
+                    next = UnitMode::Starting;
+                    break;
+                case UnitMode::Starting:
+                    if (now - enteredColumn[i] >= config.startupSeconds)
+                        next = UnitMode::Fan;
+                    break;
+                case UnitMode::Fan:
+                    if (now - compressorStopColumn[i] >= config.minOffSeconds) {
+                        if (error > config.band)
+                            next = UnitMode::Cooling;
+                        else if (error < -config.band)
+                            next = UnitMode::Heating;
+                    }
+                    break;
+                case UnitMode::Cooling:
+                    if (error <= 0.0f && now - enteredColumn[i] >= config.minRunSeconds)
+                        next = UnitMode::Fan;
+                    break;
+                case UnitMode::Heating:
+                    if (error >= 0.0f && now - enteredColumn[i] >= config.minRunSeconds)
+                        next = UnitMode::Fan;
+                    break;
+                case UnitMode::Fault:
+                    break;
+            }
+        }
+
+        if (next == current)
+            continue;
+        if (compressor)
+            compressorStopColumn[i] = now;
+        modeColumn[i] = static_cast<std::uint8_t>(next);
+        enteredColumn[i] = now;
+        ++transitions;
+    }
+    return transitions;
+}
@@ -0,0 +1,101 @@
+#ifndef AIRCONDITIONINGCONTROL_POWERSTATEMACHINE_H
+#define AIRCONDITIONINGCONTROL_POWERSTATEMACHINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FleetStore.h"
+
+/**
+ * @brief Режим работы блока.
+ */
+enum class UnitMode : std::uint8_t {
+    Off, /**< Выключен. */
+    Starting, /**< Запуск: вентилятор разгоняется, компрессор не работает. */
+    Cooling, /**< Охлаждение, компрессор работает. */
+    Heating, /**< Обогрев, компрессор работает. */
+    Fan, /**< Только вентиляция, компрессор остановлен. */
+    Fault /**< Авария; блок остается в ней до выключения питания. */
+};
+
+/**
+ * @struct PowerStateConfig
+ * @brief Временные параметры переходов между режимами.
+ */
+struct PowerStateConfig {
+    double startupSeconds = 5.0; /**< Длительность запуска перед выбором режима, с. */
+    double minRunSeconds = 120.0; /**< Наименьшее время работы компрессора, с. */
+    double minOffSeconds = 180.0; /**< Наименьшая пауза компрессора перед повторным пуском, с. */
+    float band = 0.5f; /**< Полуширина зоны, в которой компрессор не включается, °C. */
+};
+
+/**
+ * @class PowerStateMachine
+ * @brief Конечный автомат режимов работы блоков парка.
+ *
+ * Требуемое состояние питания, уставка и измеренная температура берутся из
+ * столбцов FleetStore, а режим и моменты переходов хранятся в собственных
+ * столбцах. Один вызов tick() обрабатывает весь парк за один проход без
+ * выделения памяти.
+ *
+ * Переходы: Off → Starting при включении питания; Starting → Fan по
+ * истечении startupSeconds; Fan → Cooling/Heating, когда температура выходит
+ * из зоны band вокруг уставки; Cooling/Heating → Fan по достижении уставки.
+ * Компрессор не останавливается раньше minRunSeconds после пуска и не
+ * запускается раньше minOffSeconds после остановки (защита от частых
+ * пусков). Выключение питания и авария останавливают компрессор сразу.
+ */
+class PowerStateMachine {
+public:
+    /**
+     * @brief Конструктор класса PowerStateMachine.
+     * @param config Временные параметры переходов.
+     */
+    explicit PowerStateMachine(const PowerStateConfig &config = {});
+
+    /**
+     * @brief Задает количество блоков; новые блоки выключены.
+     * @param units Количество блоков.
+     */
+    void resize(std::size_t units);
+
+    /**
+     * @brief Выполняет переходы для всех блоков парка.
+     * @param fleet Хранилище состояния блоков.
+     * @param now Текущее время по монотонным часам, с.
+     * @return Количество блоков, сменивших режим.
+     */
+    std::size_t tick(const FleetStore &fleet, double now);
+
+    /**
+     * @brief Переводит блок в аварию при следующем вызове tick().
+     * @param unit Индекс блока.
+     */
+    void reportFault(FleetStore::UnitId unit) { faultColumn[unit] = 1; }
+
+    /**
+     * @brief Возвращает режим блока.
+     * @param unit Индекс блока.
+     * @return Режим работы.
+     */
+    UnitMode mode(FleetStore::UnitId unit) const { return static_cast<UnitMode>(modeColumn[unit]); }
+
+    /**
+     * @brief Проверяет, работает ли компрессор блока.
+     * @param unit Индекс блока.
+     * @return true в режимах Cooling и Heating.
+     */
+    bool compressorRunning(FleetStore::UnitId unit) const {
+        return mode(unit) == UnitMode::Cooling || mode(unit) == UnitMode::Heating;
+    }
+
+private:
+    PowerStateConfig config; /**< Временные параметры переходов. */
+    std::vector<std::uint8_t> modeColumn; /**< Режим работы (UnitMode). */
+    std::vector<std::uint8_t> faultColumn; /**< Сообщенная, но еще не обработанная авария. */
+    std::vector<double> enteredColumn; /**< Момент входа в текущий режим, с. */
+    std::vector<double> compressorStopColumn; /**< Момент последней остановки компрессора, с. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_POWERSTATEMACHINE_H
@@ -0,0 +1,149 @@
+#include "SensorIngestion.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QLocalSocket>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+SensorIngestion::SensorIngestion(QString source, std::size_t units)
+    : source(std::move(source)), latest(units), pending(units, 0) {
+    pendingUnits.reserve(units);
+    thread = std::thread(&SensorIngestion::run, this);
+}
+
+SensorIngestion::~SensorIngestion() {
+    stopping.store(true);
+    thread.join();
+}
+
+std::size_t SensorIngestion::drain(std::vector<SensorReading> &out) {
+    out.clear();
+    std::lock_guard lock(mutex);
+    for (auto unit: pendingUnits) {
+        out.push_back(latest[unit]);
+        pending[unit] = 0;
+    }
+    pendingUnits.clear();
+    return out.size();
+}
+
+void SensorIngestion::run() {
+    if (QFileInfo(source).isFile()) {
+        QFile file(source);
+        if (file.open(QIODevice::ReadOnly))
+            readDevice(file, true);
+        return;
+    }
+
+    while (!stopping.load()) {
+        QLocalSocket socket;
+        socket.connectToServer(source, QIODevice::ReadOnly);
+        if (socket.waitForConnected(reconnectIntervalMs))
+            readDevice(socket, false);
+        else
+            sleepUntil(std::chrono::steady_clock::now() + std::chrono::milliseconds(reconnectIntervalMs));
+    }
+}
+
+void SensorIngestion::readDevice(QIODevice &device, bool replay) {
+    std::array<char, bufferSize> buffer;
+    std::array<SensorReading, batchSize> batch;
+    std::size_t used = 0;
+    std::size_t batched = 0;
+    auto *socket = qobject_cast<QLocalSocket *>(&device);
+
+    while (!stopping.load()) {
+        qint64 count = device.read(buffer.data() + used, static_cast<qint64>(buffer.size() - used));
+        if (count < 0)
+            break;
+        if (count == 0) {
+            if (!socket || socket->state() != QLocalSocket::ConnectedState)
+                break;
+            socket->waitForReadyRead(pollIntervalMs);
+            continue;
+        }
+        used += static_cast<std::size_t>(count);
+
+        std::size_t lineStart = 0;
+        for (std::size_t i = used - static_cast<std::size_t>(count); i < used; ++i) {
+            if (buffer[i] != '\n')
+                continue;
+            SensorReading reading;
+            std::string_view line(buffer.data() + lineStart, i - lineStart);
+            lineStart = i + 1;
+            if (!parseSensorLine(line, reading)) {
+                if (!line.empty() && line != "\r")
+                    malformed.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (replay) {
+                auto due = replayDueTime(reading.timestampMs);
+                if (due > std::chrono::steady_clock::now()) {
+                    publish({batch.data(), batched});
+                    batched = 0;
+                    if (!sleepUntil(due))
+                        return;
+                }
+            }
+            batch[batched++] = reading;
+            if (batched == batch.size()) {
+                publish({batch.data(), batched});
+                batched = 0;
+            }
+        }
+        if (batched > 0) {
+            publish({batch.data(), batched});
+            batched = 0;
+        }
+
+        if (lineStart > 0) {
+            std::memmove(buffer.data(), buffer.data() + lineStart, used - lineStart);
+            used -= lineStart;
+        } else if (used == buffer.size()) {
+            // Строка длиннее буфера не может быть корректной.
+            malformed.fetch_add(1, std::memory_order_relaxed);
+            used = 0;
+        }
+    }
+}
+
+std::chrono::steady_clock::time_point SensorIngestion::replayDueTime(std::int64_t timestampMs) {
+    if (!replayStarted) {
+        replayStarted = true;
+        replayFirstMs = timestampMs;
+        replayStart = std::chrono::steady_clock::now();
+    }
+    return replayStart + std::chrono::milliseconds(timestampMs - replayFirstMs);
+}
+
+void SensorIngestion::publish(std::span<const SensorReading> batch) {
+    std::lock_guard lock(mutex);
+    for (const auto &reading: batch) {
+        if (reading.unit >= latest.size())
+            continue;
+        received.fetch_add(1, std::memory_order_relaxed);
+        latest[reading.unit] = reading;
+        if (pending[reading.unit]) {
+            coalesced.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            pending[reading.unit] = 1;
+            pendingUnits.push_back(reading.unit);
+        }
+    }
+}
+
+bool SensorIngestion::sleepUntil(std::chrono::steady_clock::time_point time) const {
+    while (!stopping.load()) {
+        auto left = time - std::chrono::steady_clock::now();
+        if (left <= std::chrono::steady_clock::duration::zero())
+            return true;
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+            left, std::chrono::milliseconds(pollIntervalMs)));
+    }
+    return false;
+}
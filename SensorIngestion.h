@@ -0,0 +1,128 @@
+#ifndef AIRCONDITIONINGCONTROL_SENSORINGESTION_H
+#define AIRCONDITIONINGCONTROL_SENSORINGESTION_H
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "SensorParser.h"
+
+class QIODevice;
+
+/**
+ * @class SensorIngestion
+ * @brief Фоновый прием показаний датчиков.
+ *
+ * Источник — файл записи показаний (воспроизводится в темпе исходных меток
+ * времени) либо имя локального сокета (Unix socket или именованный канал
+ * Windows), к которому поток переподключается при обрыве. Данные читаются
+ * пачками в фиксированный буфер и разбираются без выделения памяти на
+ * отсчет. Для каждого блока хранятся только последние показания, которые
+ * поток интерфейса забирает drain() со своей частотой, поэтому датчик с
+ * частотой 1 кГц не переполняет очередь событий.
+ */
+class SensorIngestion {
+public:
+    /**
+     * @brief Конструктор класса SensorIngestion; запускает поток приема.
+     * @param source Путь к файлу записи или имя локального сокета.
+     * @param units Количество блоков; показания других блоков отбрасываются.
+     */
+    SensorIngestion(QString source, std::size_t units);
+
+    /**
+     * @brief Деструктор класса SensorIngestion; останавливает поток приема.
+     */
+    ~SensorIngestion();
+
+    SensorIngestion(const SensorIngestion &) = delete;
+    SensorIngestion &operator=(const SensorIngestion &) = delete;
+
+    /**
+     * @brief Забирает последние показания блоков, обновленных с прошлого вызова.
+     * @param out Буфер результата; очищается, емкость переиспользуется.
+     * @return Количество блоков с новыми показаниями.
+     */
+    std::size_t drain(std::vector<SensorReading> &out);
+
+    /**
+     * @brief Возвращает количество принятых показаний.
+     * @return Количество показаний.
+     */
+    std::uint64_t receivedReadings() const { return received.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает количество показаний, замененных более новыми до передачи в интерфейс.
+     * @return Количество показаний.
+     */
+    std::uint64_t coalescedReadings() const { return coalesced.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает количество строк, не прошедших разбор.
+     * @return Количество строк.
+     */
+    std::uint64_t malformedLines() const { return malformed.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t bufferSize = 64 * 1024; /**< Размер буфера чтения, байт. */
+    static constexpr std::size_t batchSize = 256; /**< Показаний в одной пачке публикации. */
+    static constexpr int pollIntervalMs = 100; /**< Период проверки запроса остановки, мс. */
+    static constexpr int reconnectIntervalMs = 1000; /**< Период переподключения к сокету, мс. */
+
+    /**
+     * @brief Цикл фонового потока.
+     */
+    void run();
+
+    /**
+     * @brief Читает и разбирает данные устройства до конца потока или остановки.
+     * @param device Источник данных.
+     * @param replay true для файла записи: показания воспроизводятся в темпе меток времени.
+     */
+    void readDevice(QIODevice &device, bool replay);
+
+    /**
+     * @brief Вычисляет момент воспроизведения показаний из файла записи.
+     * @param timestampMs Метка времени показаний.
+     * @return Момент, не раньше которого показания передаются в интерфейс.
+     */
+    std::chrono::steady_clock::time_point replayDueTime(std::int64_t timestampMs);
+
+    /**
+     * @brief Передает пачку показаний в общий буфер под одной блокировкой.
+     * @param batch Показания.
+     */
+    void publish(std::span<const SensorReading> batch);
+
+    /**
+     * @brief Ожидает заданного момента, периодически проверяя запрос остановки.
+     * @param time Момент окончания ожидания.
+     * @return false, если во время ожидания запрошена остановка.
+     */
+    bool sleepUntil(std::chrono::steady_clock::time_point time) const;
+
+    QString source; /**< Путь к файлу записи или имя локального сокета. */
+    std::atomic<bool> stopping{false}; /**< Запрошена остановка потока. */
+    std::atomic<std::uint64_t> received{0}; /**< Количество принятых показаний. */
+    std::atomic<std::uint64_t> coalesced{0}; /**< Количество замененных показаний. */
+    std::atomic<std::uint64_t> malformed{0}; /**< Количество некорректных строк. */
+
+    bool replayStarted = false; /**< Получены ли первые показания из файла записи. */
+    std::int64_t replayFirstMs = 0; /**< Метка времени первых показаний файла записи. */
+    std::chrono::steady_clock::time_point replayStart; /**< Момент воспроизведения первых показаний. */
+
+    std::mutex mutex; /**< Защищает поля ниже. */
+    std::vector<SensorReading> latest; /**< Последние показания каждого блока. */
+    std::vector<std::uint8_t> pending; /**< Есть ли у блока непереданные показания. */
+    std::vector<FleetStore::UnitId> pendingUnits; /**< Блоки с непереданными показаниями. */
+
+    std::thread thread; /**< Поток приема. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_SENSORINGESTION_H
@@ -0,0 +1,47 @@
+#include "SensorParser.h"
+
+#include <charconv>
+#include <cmath>
+
+/**
+ * @brief Пропускает пробелы и табуляцию.
+ * @param first Начало текста.
+ * @param last Конец текста.
+ * @return Указатель на первый непробельный символ.
+ */
+static const char *skipBlanks(const char *first, const char *last) {
+    while (first != last && (*first == ' ' || *first == '\t' || *first == '\r'))
+        ++first;
+    return first;
+}
+
+/**
+ * @brief Разбирает очередное числовое поле строки.
+ * @param first Текущая позиция; сдвигается за разобранное поле.
+ * @param last Конец строки.
+ * @param value Результат разбора.
+ * @return true, если поле разобрано.
+ */
+template<typename T>
+static bool parseField(const char *&first, const char *last, T &value) {
+    first = skipBlanks(first, last);
+    auto [end, error] = std::from_chars(first, last, value);
+    if (error != std::errc() || end == first)
+        return false;
+    first = end;
+    return true;
+}
+
+bool parseSensorLine(std::string_view line, SensorReading &reading) {
+    const char *first = line.data();
+    const char *last = line.data() + line.size();
+    return parseField(first, last, reading.timestampMs)
+           && parseField(first, last, reading.unit)
+           && parseField(first, last, reading.temperature)
+           && parseField(first, last, reading.pressure)
+           && parseField(first, last, reading.humidity)
+           && skipBlanks(first, last) == last
+           && std::isfinite(reading.temperature)
+           && std::isfinite(reading.pressure)
+           && std::isfinite(reading.humidity);
+}
@@ -0,0 +1,34 @@
+#ifndef AIRCONDITIONINGCONTROL_SENSORPARSER_H
+#define AIRCONDITIONINGCONTROL_SENSORPARSER_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "FleetStore.h"
+
+/**
+ * @struct SensorReading
+ * @brief Показания датчиков одного блока.
+ */
+struct SensorReading {
+    std::int64_t timestampMs = 0; /**< Время снятия показаний, мс. */
+    FleetStore::UnitId unit = 0; /**< Индекс блока. */
+    float temperature = 0; /**< Температура воздуха, °C. */
+    float pressure = 0; /**< Давление, Па. */
+    float humidity = 0; /**< Влажность, %. */
+};
+
+/**
+ * @brief Разбирает строку показаний датчиков.
+ *
+ * Формат строки: "<время, мс> <блок> <температура> <давление> <влажность>",
+ * поля разделены пробелами или табуляцией. Разбор выполняется std::from_chars
+ * без выделения памяти. Строки с nan или inf в показаниях отбрасываются.
+ *
+ * @param line Строка без символа перевода строки.
+ * @param reading Результат разбора.
+ * @return true, если строка имеет корректный формат.
+ */
+bool parseSensorLine(std::string_view line, SensorReading &reading);
+
+#endif //AIRCONDITIONINGCONTROL_SENSORPARSER_H
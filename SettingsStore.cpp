@@ -0,0 +1,131 @@
+#include "SettingsStore.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <bit>
+
+#include "Airflow.h"
+#include "ControlCore.h"
+
+/*
+ * Заголовок:
+ *   0  quint32 magic
+ *   4  quint32 version
+ *   8  qint32  temperatureUnit
+ *   12 qint32  pressureUnit
+ *   16 quint32 unitCount
+ *   20 quint32 recordSize
+ * Запись блока:
+ *   0  qint16  setpoint
+ *   2  quint8  humidity
+ *   3  quint8  flags: бит 0 — питание, бит 1 — качание жалюзи
+ *   4  qint32  pressure
+ *   8  float   airflowAngle
+ *   12 float   airflowStrength
+ * В версии 1 запись занимала 12 байт, в flags был только бит питания, а
+ * вместо угла и силы обдува хранилось смещение точки обдува
+ * (AirflowDirection::x(), y()), округленное до единицы сцены:
+ *   8  qint16  airflowX
+ *   10 qint16  airflowY
+ */
+
+namespace {
+
+constexpr uchar powerFlag = 1; /**< Бит питания в flags. */
+constexpr uchar sweepFlag = 2; /**< Бит качания жалюзи в flags. */
+
+void putFloat(float value, uchar *data) {
+    qToLittleEndian<quint32>(std::bit_cast<quint32>(value), data);
+}
+
+float getFloat(const uchar *data) {
+    return std::bit_cast<float>(qFromLittleEndian<quint32>(data));
+}
+
+} // namespace
+
+bool SettingsStore::load(DisplaySettings &display, FleetStore &fleet) const {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < headerSize)
+        return false;
+
+    const uchar *data = file.map(0, file.size());
+    if (!data)
+        return false;
+
+    quint32 fileVersion = qFromLittleEndian<quint32>(data + 4);
+    qint64 fileRecordSize = fileVersion == 1 ? recordSizeV1 : recordSize;
+    bool valid = qFromLittleEndian<quint32>(data) == magic
+                 && (fileVersion == 1 || fileVersion == version)
+                 && qFromLittleEndian<quint32>(data + 20) == fileRecordSize;
+    quint32 unitCount = valid ? qFromLittleEndian<quint32>(data + 16) : 0;
+    valid = valid && file.size() >= headerSize + qint64(unitCount) * fileRecordSize;
+
+    if (valid) {
+        display.temperatureUnit = qFromLittleEndian<qint32>(data + 8);
+        display.pressureUnit = qFromLittleEndian<qint32>(data + 12);
+
+        auto count = std::min<std::size_t>(unitCount, fleet.size());
+        for (std::size_t unit = 0; unit < count; ++unit) {
+            const uchar *record = data + headerSize + qint64(unit) * fileRecordSize;
+            auto id = static_cast<FleetStore::UnitId>(unit);
+            // Уставка ограничивается так же, как при воспроизведении журнала через ControlCore.
+            fleet.setSetpoint(id, std::clamp<int>(qFromLittleEndian<qint16>(record), ControlCore::minTemperature,
+                                                  ControlCore::maxTemperature));
+            fleet.setPowered(id, (record[3] & powerFlag) != 0);
+            fleet.setAirflowSweep(id, (record[3] & sweepFlag) != 0);
+            if (fileVersion == 1) {
+                auto airflow = AirflowDirection::fromVector(qFromLittleEndian<qint16>(record + 8),
+                                                            qFromLittleEndian<qint16>(record + 10));
+                fleet.setAirflow(id, airflow.angle, airflow.strength);
+            } else {
+                fleet.setAirflow(id, normalizeAngle(getFloat(record + 8)),
+                                 std::clamp(getFloat(record + 12), 0.0f, 1.0f));
+            }
+        }
+    }
+
+    file.unmap(const_cast<uchar *>(data));
+    file.close();
+    return valid;
+}
+
+QByteArray SettingsStore::encode(const DisplaySettings &display, const FleetStore &fleet) {
+    QByteArray buffer(headerSize + qint64(fleet.size()) * recordSize, Qt::Uninitialized);
+    auto *data = reinterpret_cast<uchar *>(buffer.data());
+
+    qToLittleEndian<quint32>(magic, data);
+    qToLittleEndian<quint32>(version, data + 4);
+    qToLittleEndian<qint32>(display.temperatureUnit, data + 8);
+    qToLittleEndian<qint32>(display.pressureUnit, data + 12);
+    qToLittleEndian<quint32>(static_cast<quint32>(fleet.size()), data + 16);
+    qToLittleEndian<quint32>(recordSize, data + 20);
+
+    for (std::size_t unit = 0; unit < fleet.size(); ++unit) {
+        uchar *record = data + headerSize + qint64(unit) * recordSize;
+        auto id = static_cast<FleetStore::UnitId>(unit);
+        qToLittleEndian<qint16>(static_cast<qint16>(fleet.setpoint(id)), record);
+        record[2] = static_cast<uchar>(fleet.humidity(id));
+        record[3] = static_cast<uchar>((fleet.isPowered(id) ? powerFlag : 0) |
+                                       (fleet.airflowSweep(id) ? sweepFlag : 0));
+        qToLittleEndian<qint32>(fleet.pressure(id), record + 4);
+        putFloat(fleet.airflowAngle(id), record + 8);
+        putFloat(fleet.airflowStrength(id), record + 12);
+    }
+
+    return buffer;
+}
+
+bool SettingsStore::commit(const QByteArray &image) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    if (file.write(image) != image.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
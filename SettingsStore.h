@@ -0,0 +1,89 @@
+#ifndef AIRCONDITIONINGCONTROL_SETTINGSSTORE_H
+#define AIRCONDITIONINGCONTROL_SETTINGSSTORE_H
+
+#include <QByteArray>
+#include <QString>
+
+#include <utility>
+
+#include "FleetStore.h"
+
+/**
+ * @struct DisplaySettings
+ * @brief Настройки отображения, сохраняемые между запусками.
+ */
+struct DisplaySettings {
+    int temperatureUnit = 0; /**< Индекс единиц измерения температуры. */
+    int pressureUnit = 0; /**< Индекс единиц измерения давления. */
+};
+
+/**
+ * @class SettingsStore
+ * @brief Двоичное хранилище настроек фиксированного формата.
+ *
+ * Файл состоит из заголовка и массива записей одинакового размера, по одной
+ * на блок; все числа хранятся в little-endian. При запуске файл отображается
+ * в память только для чтения. Запись идет во временный файл, который затем
+ * атомарно переименовывается, поэтому сбой посреди записи не портит
+ * предыдущую версию настроек.
+ */
+class SettingsStore {
+public:
+    static constexpr quint32 magic = 0x53434341; /**< Сигнатура файла ("ACCS"). */
+    static constexpr quint32 version = 2; /**< Версия формата. */
+    static constexpr qint64 headerSize = 24; /**< Размер заголовка, байт. */
+    static constexpr qint64 recordSize = 16; /**< Размер записи блока, байт. */
+    static constexpr qint64 recordSizeV1 = 12; /**< Размер записи блока в версии 1, байт. */
+
+    /**
+     * @brief Конструктор класса SettingsStore.
+     * @param path Путь к файлу настроек.
+     */
+    explicit SettingsStore(QString path) : path(std::move(path)) {}
+
+    /**
+     * @brief Загружает настройки из файла.
+     *
+     * Восстанавливаются настройки отображения, а также уставка, питание,
+     * направление и качание обдува блоков, присутствующих и в файле, и в
+     * парке, — то же состояние, что восстанавливает журнал команд. Показания
+     * датчиков задаются при запуске и из файла не читаются. Файлы версии 1
+     * читаются тоже; направление обдува в них округлено до единицы сцены, а
+     * качание не хранится.
+     *
+     * @param display Настройки отображения.
+     * @param fleet Хранилище состояния блоков.
+     * @return true, если файл существует и имеет корректный формат.
+     */
+    bool load(DisplaySettings &display, FleetStore &fleet) const;
+
+    /**
+     * @brief Сериализует настройки в образ файла.
+     * @param display Настройки отображения.
+     * @param fleet Хранилище состояния блоков.
+     * @return Содержимое файла настроек.
+     */
+    static QByteArray encode(const DisplaySettings &display, const FleetStore &fleet);
+
+    /**
+     * @brief Атомарно заменяет файл настроек готовым образом.
+     * @param image Содержимое файла, полученное из encode().
+     * @return true, если запись прошла успешно.
+     */
+    bool commit(const QByteArray &image) const;
+
+    /**
+     * @brief Синхронно сохраняет настройки в файл.
+     * @param display Настройки отображения.
+     * @param fleet Хранилище состояния блоков.
+     * @return true, если запись прошла успешно.
+     */
+    bool save(const DisplaySettings &display, const FleetStore &fleet) const {
+        return commit(encode(display, fleet));
+    }
+
+private:
+    QString path; /**< Путь к файлу настроек. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_SETTINGSSTORE_H
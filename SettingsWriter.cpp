@@ -0,0 +1,80 @@
+#include "SettingsWriter.h"
+
+#include <utility>
+
+#include "Instrumentation.h"
+
+SettingsWriter::SettingsWriter(const SettingsStore &store) : store(store), thread(&SettingsWriter::run, this) {
+}
+
+SettingsWriter::~SettingsWriter() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    thread.join();
+}
+
+void SettingsWriter::schedule(QByteArray image, std::function<void()> onCommitted) {
+    {
+        std::lock_guard lock(mutex);
+        if (hasPending)
+            ++coalesced;
+        pending = std::move(image);
+        pendingHandler = std::move(onCommitted);
+        hasPending = true;
+    }
+    wakeUp.notify_one();
+}
+
+bool SettingsWriter::flush() {
+    std::unique_lock lock(mutex);
+    idle.wait(lock, [this] { return !hasPending && !writing; });
+    return lastWritten;
+}
+
+std::uint64_t SettingsWriter::coalescedWrites() const {
+    std::lock_guard lock(mutex);
+    return coalesced;
+}
+
+std::uint64_t SettingsWriter::failedWrites() const {
+    std::lock_guard lock(mutex);
+    return failed;
+}
+
+void SettingsWriter::run() {
+    Instrumentation::setThreadName("settings-writer");
+    std::unique_lock lock(mutex);
+    for (;;) {
+        wakeUp.wait(lock, [this] { return hasPending || stopping; });
+        if (!hasPending)
+            return;
+
+        QByteArray image = std::move(pending);
+        pending = QByteArray();
+        std::function<void()> onCommitted = std::move(pendingHandler);
+        pendingHandler = nullptr;
+        hasPending = false;
+        writing = true;
+
+        lock.unlock();
+        bool written;
+        {
+            ScopedLatency latency(Instrumentation::SettingsCommit);
+            written = store.commit(image);
+        }
+        Instrumentation::count(written ? Instrumentation::SettingsWrites : Instrumentation::SettingsWriteFailures);
+        // Обработчик выполняется до сигнала idle, чтобы flush() дожидался и его.
+        if (written && onCommitted)
+            onCommitted();
+        lock.lock();
+
+        if (!written)
+            ++failed;
+        writing = false;
+        lastWritten = written;
+        idle.notify_all();
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef AIRCONDITIONINGCONTROL_SETTINGSWRITER_H
+#define AIRCONDITIONINGCONTROL_SETTINGSWRITER_H
+
+#include <QByteArray>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "SettingsStore.h"
+
+/**
+ * @class SettingsWriter
+ * @brief Фоновая запись настроек в отдельном потоке.
+ *
+ * schedule() только передает готовый образ файла и сразу возвращает
+ * управление. Если поток еще не успел записать предыдущий образ, тот
+ * заменяется новым, так что на диск попадает лишь последняя версия.
+ * Деструктор дожидается записи последнего запланированного образа.
+ * Обработчик, переданный с образом, вызывается в потоке записи только
+ * после успешной записи именно этого образа.
+ */
+class SettingsWriter {
+public:
+    /**
+     * @brief Конструктор класса SettingsWriter.
+     * @param store Хранилище, в которое выполняется запись.
+     */
+    explicit SettingsWriter(const SettingsStore &store);
+
+    /**
+     * @brief Деструктор класса SettingsWriter.
+     */
+    ~SettingsWriter();
+
+    SettingsWriter(const SettingsWriter &) = delete;
+    SettingsWriter &operator=(const SettingsWriter &) = delete;
+
+    /**
+     * @brief Планирует запись образа настроек.
+     * @param image Содержимое файла, полученное из SettingsStore::encode().
+     * @param onCommitted Обработчик успешной записи образа; не вызывается, если образ
+     * заменен более новым или не записан.
+     */
+    void schedule(QByteArray image, std::function<void()> onCommitted = {});
+
+    /**
+     * @brief Дожидается записи всех запланированных образов.
+     * @return true, если последняя запись прошла успешно.
+     */
+    bool flush();
+
+    /**
+     * @brief Возвращает количество образов, замененных более новыми до записи.
+     * @return Количество объединенных записей.
+     */
+    std::uint64_t coalescedWrites() const;
+
+    /**
+     * @brief Возвращает количество неудачных записей.
+     * @return Количество ошибок записи.
+     */
+    std::uint64_t failedWrites() const;
+
+private:
+    /**
+     * @brief Цикл фонового потока.
+     */
+    void run();
+
+    const SettingsStore &store; /**< Хранилище настроек. */
+    mutable std::mutex mutex; /**< Защищает поля ниже. */
+    std::condition_variable wakeUp; /**< Сигнал о новом образе или остановке. */
+    std::condition_variable idle; /**< Сигнал о завершении записи образа. */
+    QByteArray pending; /**< Образ, ожидающий записи. */
+    std::function<void()> pendingHandler; /**< Обработчик записи образа, ожидающего записи. */
+    bool hasPending = false; /**< Есть ли образ, ожидающий записи. */
+    bool writing = false; /**< Записывается ли образ сейчас. */
+    bool lastWritten = true; /**< Успешна ли последняя запись. */
+    bool stopping = false; /**< Запрошена остановка потока. */
+    std::uint64_t coalesced = 0; /**< Количество объединенных записей. */
+    std::uint64_t failed = 0; /**< Количество ошибок записи. */
+    std::thread thread; /**< Поток записи. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_SETTINGSWRITER_H
@@ -0,0 +1,98 @@
+#include "SettingsXml.h"
+
+#include <QFile>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+#include <algorithm>
+
+#include "Airflow.h"
+#include "ControlCore.h"
+
+/**
+ * @brief Восстанавливает уставку, питание, направление и качание обдува блока из элемента Unit.
+ * @param attributes Атрибуты элемента.
+ * @param fleet Хранилище состояния блоков.
+ */
+static void readUnit(const QXmlStreamAttributes &attributes, FleetStore &fleet) {
+    bool ok = false;
+    uint id = attributes.value("id").toUInt(&ok);
+    if (!ok || id >= fleet.size())
+        return;
+
+    auto unit = static_cast<FleetStore::UnitId>(id);
+    if (attributes.hasAttribute("setpoint"))
+        fleet.setSetpoint(unit, std::clamp(attributes.value("setpoint").toInt(), ControlCore::minTemperature,
+                                           ControlCore::maxTemperature));
+    if (attributes.hasAttribute("power"))
+        fleet.setPowered(unit, attributes.value("power").toInt() != 0);
+    if (attributes.hasAttribute("airflowAngle") && attributes.hasAttribute("airflowStrength")) {
+        fleet.setAirflow(unit, normalizeAngle(attributes.value("airflowAngle").toFloat()),
+                         std::clamp(attributes.value("airflowStrength").toFloat(), 0.0f, 1.0f));
+    } else if (attributes.hasAttribute("airflowX") && attributes.hasAttribute("airflowY")) {
+        auto airflow = AirflowDirection::fromVector(attributes.value("airflowX").toFloat(),
+                                                    attributes.value("airflowY").toFloat());
+        fleet.setAirflow(unit, airflow.angle, airflow.strength);
+    }
+    if (attributes.hasAttribute("sweep"))
+        fleet.setAirflowSweep(unit, attributes.value("sweep").toInt() != 0);
+}
+
+bool readSettingsXml(const QString &path, DisplaySettings &display, FleetStore &fleet) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QXmlStreamReader reader(&file);
+    if (!reader.readNextStartElement() || reader.name() != QLatin1String("Settings"))
+        return false;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("TemperatureUnit")) {
+            display.temperatureUnit = reader.attributes().value("index").toInt();
+        } else if (reader.name() == QLatin1String("PressureUnit")) {
+            display.pressureUnit = reader.attributes().value("index").toInt();
+        } else if (reader.name() == QLatin1String("Unit")) {
+            readUnit(reader.attributes(), fleet);
+        }
+        reader.skipCurrentElement();
+    }
+    return !reader.hasError();
+}
+
+bool writeSettingsXml(const QString &path, const DisplaySettings &display, const FleetStore &fleet) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QXmlStreamWriter writer(&file);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+    writer.writeStartElement("Settings");
+
+    writer.writeEmptyElement("TemperatureUnit");
+    writer.writeAttribute("index", QString::number(display.temperatureUnit));
+    writer.writeEmptyElement("PressureUnit");
+    writer.writeAttribute("index", QString::number(display.pressureUnit));
+
+    for (std::size_t unit = 0; unit < fleet.size(); ++unit) {
+        auto id = static_cast<FleetStore::UnitId>(unit);
+        writer.writeEmptyElement("Unit");
+        writer.writeAttribute("id", QString::number(id));
+        writer.writeAttribute("setpoint", QString::number(fleet.setpoint(id)));
+        writer.writeAttribute("pressure", QString::number(fleet.pressure(id)));
+        writer.writeAttribute("humidity", QString::number(fleet.humidity(id)));
+        writer.writeAttribute("power", QString::number(fleet.isPowered(id) ? 1 : 0));
+        AirflowDirection airflow{fleet.airflowAngle(id), fleet.airflowStrength(id)};
+        writer.writeAttribute("airflowX", QString::number(airflow.x()));
+        writer.writeAttribute("airflowY", QString::number(airflow.y()));
+        // Угол и сила записываются с точностью float, чтобы импорт не искажал направление.
+        writer.writeAttribute("airflowAngle", QString::number(airflow.angle, 'g', 9));
+        writer.writeAttribute("airflowStrength", QString::number(airflow.strength, 'g', 9));
+        writer.writeAttribute("sweep", QString::number(fleet.airflowSweep(id) ? 1 : 0));
+    }
+
+    writer.writeEndElement();
+    writer.writeEndDocument();
+    return !writer.hasError();
+}
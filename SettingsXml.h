@@ -0,0 +1,31 @@
+#ifndef AIRCONDITIONINGCONTROL_SETTINGSXML_H
+#define AIRCONDITIONINGCONTROL_SETTINGSXML_H
+
+#include <QString>
+
+#include "SettingsStore.h"
+
+/**
+ * @brief Потоково читает настройки из XML файла.
+ *
+ * Файл разбирается QXmlStreamReader без построения DOM, поэтому память не
+ * зависит от размера файла. Читаются только элементы TemperatureUnit,
+ * PressureUnit и Unit, остальные пропускаются целиком.
+ *
+ * @param path Путь к XML файлу.
+ * @param display Настройки отображения.
+ * @param fleet Хранилище состояния блоков.
+ * @return true, если файл прочитан без ошибок разбора.
+ */
+bool readSettingsXml(const QString &path, DisplaySettings &display, FleetStore &fleet);
+
+/**
+ * @brief Потоково записывает настройки в XML файл.
+ * @param path Путь к XML файлу.
+ * @param display Настройки отображения.
+ * @param fleet Хранилище состояния блоков.
+ * @return true, если запись прошла успешно.
+ */
+bool writeSettingsXml(const QString &path, const DisplaySettings &display, const FleetStore &fleet);
+
+#endif //AIRCONDITIONINGCONTROL_SETTINGSXML_H
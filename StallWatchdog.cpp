@@ -0,0 +1,97 @@
+#include "StallWatchdog.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "Instrumentation.h"
+
+namespace {
+
+double toMs(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+std::string formatStallReport(const StallReport &report) {
+    char line[160];
+    if (report.handler)
+        std::snprintf(line, sizeof(line), "event loop stalled for %.0f ms in %s (%.0f ms), watchdog lag %.0f ms",
+                      report.stallMs, report.handler, report.handlerMs, report.watchdogLagMs);
+    else
+        std::snprintf(line, sizeof(line), "event loop stalled for %.0f ms outside handlers, watchdog lag %.0f ms",
+                      report.stallMs, report.watchdogLagMs);
+    return line;
+}
+
+StallWatchdog::StallWatchdog(std::chrono::milliseconds threshold, Reporter reporter)
+    : threshold(threshold), interval(std::max(threshold / 4, std::chrono::milliseconds(1))),
+      reporter(std::move(reporter)), lastBeat(Clock::now().time_since_epoch().count()) {
+    Instrumentation::watchCurrentThread();
+    thread = std::thread(&StallWatchdog::run, this);
+}
+
+StallWatchdog::~StallWatchdog() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    thread.join();
+    Instrumentation::stopWatching();
+}
+
+void StallWatchdog::heartbeat() noexcept {
+    lastBeat.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void StallWatchdog::run() {
+    Instrumentation::setThreadName("watchdog");
+    std::unique_lock lock(mutex);
+    auto wake = Clock::now() + interval;
+    bool stalled = false;
+    Clock::time_point stallBeat;
+    StallReport report;
+
+    while (!wakeUp.wait_until(lock, wake, [this] { return stopping; })) {
+        auto now = Clock::now();
+        auto lag = now - wake;
+        wake = now + interval;
+        Clock::time_point beat{Clock::duration(lastBeat.load(std::memory_order_relaxed))};
+
+        if (!stalled) {
+            // Проспал сам сторожевой поток: останавливалась вся машина или процесс,
+            // и отслеживаемый поток мог успеть отметиться до этой проверки.
+            if (lag > threshold) {
+                ++stallCount;
+                report = StallReport{toMs(lag), nullptr, 0, toMs(lag)};
+                lock.unlock();
+                reporter(report);
+                lock.lock();
+                continue;
+            }
+            if (now - beat <= threshold)
+                continue;
+            stalled = true;
+            stallBeat = beat;
+            report = StallReport{};
+        } else if (beat != stallBeat) {
+            report.stallMs = std::max(0.0, toMs(beat - stallBeat - interval));
+            stalled = false;
+            ++stallCount;
+            lock.unlock();
+            reporter(report);
+            lock.lock();
+            continue;
+        }
+
+        report.watchdogLagMs = std::max(report.watchdogLagMs, toMs(lag));
+        Instrumentation::Probe probe;
+        Clock::time_point since;
+        if (Instrumentation::activeHandler(probe, since) && toMs(now - since) > report.handlerMs) {
+            report.handler = Instrumentation::name(probe);
+            report.handlerMs = toMs(now - since);
+        }
+    }
+}
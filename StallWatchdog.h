@@ -0,0 +1,105 @@
+#ifndef AIRCONDITIONINGCONTROL_STALLWATCHDOG_H
+#define AIRCONDITIONINGCONTROL_STALLWATCHDOG_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @struct StallReport
+ * @brief Сведения об одной остановке цикла событий.
+ */
+struct StallReport {
+    double stallMs = 0; /**< Длительность остановки, мс. */
+    const char *handler = nullptr; /**< Участок Instrumentation, выполнявшийся дольше всех, или nullptr. */
+    double handlerMs = 0; /**< Время выполнения этого участка к последней проверке, мс. */
+    double watchdogLagMs = 0; /**< Наибольшее опоздание пробуждения сторожевого потока, мс. */
+};
+
+/**
+ * @brief Формирует однострочное описание остановки для журнала.
+ * @param report Сведения об остановке.
+ * @return Текст описания.
+ */
+std::string formatStallReport(const StallReport &report);
+
+/**
+ * @class StallWatchdog
+ * @brief Сторожевой поток, обнаруживающий остановки цикла событий.
+ *
+ * Отслеживаемый поток периодически вызывает heartbeat() из своего цикла
+ * событий (например, по QTimer с периодом heartbeatInterval()). Сторожевой
+ * поток проверяет время последнего вызова четыре раза за порог; если оно
+ * старше порога, поток считается остановленным, и до возобновления вызовов
+ * запоминается участок Instrumentation, выполнявшийся дольше всех. После
+ * возобновления отчет передается обработчику из сторожевого потока.
+ *
+ * Опоздание пробуждения самого сторожевого потока показывает, была ли
+ * остановка вызвана приложением (опоздания нет) или всей машиной:
+ * нехваткой процессора, подкачкой или приостановкой процесса.
+ */
+class StallWatchdog {
+public:
+    using Reporter = std::function<void(const StallReport &)>;
+
+    /**
+     * @brief Конструктор класса StallWatchdog; запускает сторожевой поток.
+     *
+     * Вызывается из отслеживаемого потока: он становится потоком, для
+     * которого Instrumentation отмечает выполняемый участок.
+     *
+     * @param threshold Порог остановки.
+     * @param reporter Обработчик отчетов; вызывается из сторожевого потока.
+     */
+    StallWatchdog(std::chrono::milliseconds threshold, Reporter reporter);
+
+    /**
+     * @brief Деструктор класса StallWatchdog; останавливает сторожевой поток.
+     */
+    ~StallWatchdog();
+
+    StallWatchdog(const StallWatchdog &) = delete;
+    StallWatchdog &operator=(const StallWatchdog &) = delete;
+
+    /**
+     * @brief Отмечает, что цикл событий отслеживаемого потока работает.
+     */
+    void heartbeat() noexcept;
+
+    /**
+     * @brief Возвращает рекомендуемый период вызова heartbeat().
+     * @return Период, мс.
+     */
+    std::chrono::milliseconds heartbeatInterval() const { return interval; }
+
+    /**
+     * @brief Возвращает количество обнаруженных остановок.
+     * @return Количество остановок.
+     */
+    std::uint64_t stalls() const { return stallCount.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Цикл сторожевого потока.
+     */
+    void run();
+
+    std::chrono::milliseconds threshold; /**< Порог остановки. */
+    std::chrono::milliseconds interval; /**< Период вызова heartbeat() и проверок. */
+    Reporter reporter; /**< Обработчик отчетов. */
+    std::atomic<Clock::rep> lastBeat; /**< Время последнего вызова heartbeat(). */
+    std::atomic<std::uint64_t> stallCount{0}; /**< Количество обнаруженных остановок. */
+    std::mutex mutex; /**< Защищает stopping. */
+    std::condition_variable wakeUp; /**< Будит поток при остановке. */
+    bool stopping = false; /**< Запрошена остановка потока. */
+    std::thread thread; /**< Сторожевой поток. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_STALLWATCHDOG_H
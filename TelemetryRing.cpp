@@ -0,0 +1,59 @@
+#include "TelemetryRing.h"
+
+#include <algorithm>
+#include <bit>
+
+TelemetryRing::TelemetryRing(std::size_t capacity)
+    : cells(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))),
+      mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1) {
+}
+
+void TelemetryRing::append(const TelemetrySample &sample) noexcept {
+    std::uint64_t index = claimed.load(std::memory_order_relaxed);
+    // Читатель, увидевший новые данные ячейки, увидит и увеличенный claimed.
+    claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot &slot = cells[index & mask];
+    slot.timestampMs.store(sample.timestampMs, std::memory_order_relaxed);
+    slot.temperature.store(sample.temperature, std::memory_order_relaxed);
+    slot.pressure.store(sample.pressure, std::memory_order_relaxed);
+    slot.humidity.store(sample.humidity, std::memory_order_relaxed);
+
+    published.store(index + 1, std::memory_order_release);
+}
+
+std::size_t TelemetryRing::snapshot(std::span<TelemetrySample> out) const noexcept {
+    std::uint64_t end = published.load(std::memory_order_acquire);
+    std::uint64_t count = std::min<std::uint64_t>({end, out.size(), capacity()});
+    std::uint64_t begin = end - count;
+
+    for (std::uint64_t index = begin; index < end; ++index) {
+        const Slot &slot = cells[index & mask];
+        TelemetrySample &sample = out[index - begin];
+        sample.timestampMs = slot.timestampMs.load(std::memory_order_relaxed);
+        sample.temperature = slot.temperature.load(std::memory_order_relaxed);
+        sample.pressure = slot.pressure.load(std::memory_order_relaxed);
+        sample.humidity = slot.humidity.load(std::memory_order_relaxed);
+    }
+
+    // Отсчет index перезаписывается записью index + capacity; если она уже
+    // начата, скопированное значение могло быть испорчено.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t writing = claimed.load(std::memory_order_relaxed);
+    std::uint64_t firstValid = writing > capacity() ? writing - capacity() : 0;
+    if (firstValid <= begin)
+        return count;
+    if (firstValid >= end)
+        return 0;
+
+    std::size_t dropped = firstValid - begin;
+    std::copy(out.begin() + dropped, out.begin() + count, out.begin());
+    return count - dropped;
+}
+
+TelemetryRing &TelemetryHistory::ring(FleetStore::UnitId unit) {
+    if (!rings[unit])
+        rings[unit] = std::make_unique<TelemetryRing>(ringCapacity);
+    return *rings[unit];
+}
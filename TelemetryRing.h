@@ -0,0 +1,134 @@
+#ifndef AIRCONDITIONINGCONTROL_TELEMETRYRING_H
+#define AIRCONDITIONINGCONTROL_TELEMETRYRING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "FleetStore.h"
+
+/**
+ * @struct TelemetrySample
+ * @brief Показания блока в момент времени.
+ */
+struct TelemetrySample {
+    std::int64_t timestampMs = 0; /**< Время снятия показаний по монотонным часам, мс. */
+    float temperature = 0; /**< Температура, °C. */
+    float pressure = 0; /**< Давление, Па. */
+    float humidity = 0; /**< Влажность, %. */
+};
+
+/**
+ * @class TelemetryRing
+ * @brief Кольцевой буфер истории показаний одного блока.
+ *
+ * Буфер фиксированной емкости с одним писателем: append() выполняется за
+ * O(1) без блокировок и выделения памяти, при заполнении перезаписываются
+ * самые старые отсчеты. Читатели из других потоков получают копию последних
+ * отсчетов через snapshot(); отсчеты, которые писатель успел перезаписать во
+ * время копирования, отбрасываются.
+ */
+class TelemetryRing {
+public:
+    /**
+     * @brief Конструктор класса TelemetryRing.
+     * @param capacity Минимальная емкость; округляется вверх до степени двойки.
+     */
+    explicit TelemetryRing(std::size_t capacity);
+
+    TelemetryRing(const TelemetryRing &) = delete;
+    TelemetryRing &operator=(const TelemetryRing &) = delete;
+
+    /**
+     * @brief Добавляет отсчет. Вызывается только из потока-писателя.
+     * @param sample Отсчет.
+     */
+    void append(const TelemetrySample &sample) noexcept;
+
+    /**
+     * @brief Копирует последние отсчеты, от старых к новым.
+     * @param out Буфер назначения; копируется не больше out.size() отсчетов.
+     * @return Количество скопированных отсчетов.
+     */
+    std::size_t snapshot(std::span<TelemetrySample> out) const noexcept;
+
+    /**
+     * @brief Возвращает емкость буфера.
+     * @return Емкость буфера.
+     */
+    std::size_t capacity() const { return mask + 1; }
+
+    /**
+     * @brief Возвращает количество отсчетов, добавленных за все время.
+     * @return Количество добавленных отсчетов.
+     */
+    std::uint64_t appended() const { return published.load(std::memory_order_acquire); }
+
+private:
+    /**
+     * @brief Ячейка буфера; поля атомарны, чтобы чтение параллельно с записью не было гонкой данных.
+     */
+    struct Slot {
+        std::atomic<std::int64_t> timestampMs{0};
+        std::atomic<float> temperature{0};
+        std::atomic<float> pressure{0};
+        std::atomic<float> humidity{0};
+    };
+
+    std::unique_ptr<Slot[]> cells; /**< Ячейки буфера. */
+    std::size_t mask; /**< Маска индекса (емкость - 1). */
+    std::atomic<std::uint64_t> claimed{0}; /**< Количество начатых записей. */
+    std::atomic<std::uint64_t> published{0}; /**< Количество завершенных записей. */
+};
+
+/**
+ * @class TelemetryHistory
+ * @brief Набор кольцевых буферов истории, по одному на блок парка.
+ *
+ * Буфер блока создается при первом обращении, поэтому в большом парке
+ * память занимает история только тех блоков, которые записывались или
+ * просматривались. Обращаться к набору следует из потока интерфейса.
+ */
+class TelemetryHistory {
+public:
+    /**
+     * @brief Конструктор класса TelemetryHistory.
+     * @param capacity Емкость буфера каждого блока.
+     */
+    explicit TelemetryHistory(std::size_t capacity) : ringCapacity(capacity) {}
+
+    /**
+     * @brief Задает количество блоков в истории.
+     * @param units Количество блоков в парке.
+     */
+    void resize(std::size_t units) { rings.resize(std::max(units, rings.size())); }
+
+    /**
+     * @brief Возвращает буфер истории блока, создавая его при первом обращении.
+     * @param unit Индекс блока.
+     * @return Буфер истории.
+     */
+    TelemetryRing &ring(FleetStore::UnitId unit);
+
+    /**
+     * @brief Возвращает емкость буфера каждого блока.
+     * @return Емкость буфера (до округления до степени двойки).
+     */
+    std::size_t capacity() const { return ringCapacity; }
+
+    /**
+     * @brief Возвращает количество блоков в истории.
+     * @return Количество блоков.
+     */
+    std::size_t size() const { return rings.size(); }
+
+private:
+    std::size_t ringCapacity; /**< Емкость буфера каждого блока. */
+    std::vector<std::unique_ptr<TelemetryRing>> rings; /**< Буферы блоков. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_TELEMETRYRING_H
@@ -0,0 +1,94 @@
+#include "Theme.h"
+
+#include <algorithm>
+
+Theme::Theme(const QPalette &palette, const QColor &foreground)
+    : windowPalette(palette), outline(foreground), text(foreground) {
+}
+
+const Theme &Theme::light() {
+    static const Theme theme = [] {
+        QPalette palette;
+        palette.setColor(QPalette::Window, QColor(255, 255, 255));
+        palette.setColor(QPalette::WindowText, QColor(0, 0, 0));
+        palette.setColor(QPalette::Base, QColor(240, 240, 240));
+        palette.setColor(QPalette::AlternateBase, QColor(255, 255, 255));
+        palette.setColor(QPalette::ToolTipBase, QColor(255, 255, 255));
+        palette.setColor(QPalette::ToolTipText, QColor(0, 0, 0));
+        palette.setColor(QPalette::Text, QColor(0, 0, 0));
+        palette.setColor(QPalette::Button, QColor(240, 240, 240));
+        palette.setColor(QPalette::ButtonText, QColor(0, 0, 0));
+        palette.setColor(QPalette::BrightText, QColor(255, 0, 0));
+        palette.setColor(QPalette::Link, QColor(0, 0, 255));
+        palette.setColor(QPalette::Highlight, QColor(0, 120, 215));
+        palette.setColor(QPalette::HighlightedText, QColor(255, 255, 255));
+        return Theme(palette, Qt::black);
+    }();
+    return theme;
+}
+
+const Theme &Theme::dark() {
+    static const Theme theme = [] {
+        QPalette palette;
+        palette.setColor(QPalette::Window, QColor(53, 53, 53));
+        palette.setColor(QPalette::WindowText, QColor(255, 255, 255));
+        palette.setColor(QPalette::Base, QColor(25, 25, 25));
+        palette.setColor(QPalette::AlternateBase, QColor(53, 53, 53));
+        palette.setColor(QPalette::ToolTipBase, QColor(255, 255, 255));
+        palette.setColor(QPalette::ToolTipText, QColor(255, 255, 255));
+        palette.setColor(QPalette::Text, QColor(255, 255, 255));
+        palette.setColor(QPalette::Button, QColor(53, 53, 53));
+        palette.setColor(QPalette::ButtonText, QColor(255, 255, 255));
+        palette.setColor(QPalette::BrightText, QColor(255, 0, 0));
+        palette.setColor(QPalette::Link, QColor(42, 130, 218));
+        palette.setColor(QPalette::Highlight, QColor(42, 130, 218));
+        palette.setColor(QPalette::HighlightedText, QColor(0, 0, 0));
+        return Theme(palette, Qt::white);
+    }();
+    return theme;
+}
+
+void ThemeRegistry::begin(const Theme &theme, std::uint32_t roles) {
+    this->theme = &theme;
+    this->roles = roles;
+    role = 0;
+    cursor = 0;
+}
+
+bool ThemeRegistry::step(std::size_t budget) {
+    while (role < RoleCount) {
+        const auto &list = items[role];
+        if (!(roles & (1u << role)) || cursor == list.size()) {
+            ++role;
+            cursor = 0;
+            continue;
+        }
+        if (budget == 0)
+            break;
+        std::size_t last = cursor + std::min(budget, list.size() - cursor);
+        recolor(static_cast<Role>(role), cursor, last);
+        budget -= last - cursor;
+        cursor = last;
+    }
+    return role == RoleCount;
+}
+
+void ThemeRegistry::recolor(Role role, std::size_t first, std::size_t last) {
+    const auto &list = items[role];
+    switch (role) {
+        case Outline:
+            for (std::size_t i = first; i < last; ++i)
+                static_cast<QAbstractGraphicsShapeItem *>(list[i])->setPen(theme->outlinePen());
+            break;
+        case Axis:
+            for (std::size_t i = first; i < last; ++i)
+                static_cast<QGraphicsLineItem *>(list[i])->setPen(theme->outlinePen());
+            break;
+        case Label:
+            for (std::size_t i = first; i < last; ++i)
+                static_cast<QGraphicsTextItem *>(list[i])->setDefaultTextColor(theme->textColor());
+            break;
+        case RoleCount:
+            break;
+    }
+}
@@ -0,0 +1,163 @@
+#ifndef AIRCONDITIONINGCONTROL_THEME_H
+#define AIRCONDITIONINGCONTROL_THEME_H
+
+#include <QAbstractGraphicsShapeItem>
+#include <QColor>
+#include <QGraphicsLineItem>
+#include <QGraphicsTextItem>
+#include <QPalette>
+#include <QPen>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @class Theme
+ * @brief Тема оформления: палитра окна и цвета элементов сцены.
+ *
+ * Обе темы строятся один раз при первом обращении. Палитра, перо и цвет
+ * текста разделяются между всеми элементами через неявное разделение
+ * данных Qt, поэтому переключение темы не создает новых объектов.
+ */
+class Theme {
+public:
+    /**
+     * @brief Возвращает светлую тему.
+     * @return Светлая тема.
+     */
+    static const Theme &light();
+
+    /**
+     * @brief Возвращает темную тему.
+     * @return Темная тема.
+     */
+    static const Theme &dark();
+
+    /**
+     * @brief Возвращает палитру окна.
+     * @return Палитра окна.
+     */
+    const QPalette &palette() const { return windowPalette; }
+
+    /**
+     * @brief Возвращает перо контуров и осей на сценах.
+     * @return Перо контуров.
+     */
+    const QPen &outlinePen() const { return outline; }
+
+    /**
+     * @brief Возвращает цвет надписей на сценах.
+     * @return Цвет надписей.
+     */
+    const QColor &textColor() const { return text; }
+
+private:
+    /**
+     * @brief Конструктор класса Theme.
+     * @param palette Палитра окна.
+     * @param foreground Цвет контуров и надписей на сценах.
+     */
+    Theme(const QPalette &palette, const QColor &foreground);
+
+    QPalette windowPalette; /**< Палитра окна. */
+    QPen outline; /**< Перо контуров и осей. */
+    QColor text; /**< Цвет надписей. */
+};
+
+/**
+ * @class ThemeRegistry
+ * @brief Реестр элементов сцен, окрашиваемых по теме, с индексом по ролям.
+ *
+ * Элементы регистрируются при создании интерфейса в список своей роли, так
+ * что смена темы проходит только по ним, не перебирая сцены и не создавая
+ * временных списков. Перекраску можно выполнять порциями: begin() задает
+ * тему и набор ролей, а каждый вызов step() обрабатывает не больше заданного
+ * числа элементов, продолжая с места предыдущего вызова. Так смена темы на
+ * десятках тысяч элементов распределяется по нескольким кадрам.
+ * Элементы должны существовать дольше реестра.
+ */
+class ThemeRegistry {
+public:
+    /**
+     * @brief Роль элемента, определяющая, какой цвет темы он получает.
+     */
+    enum Role : std::uint32_t {
+        Outline, /**< Контур (прямоугольник, эллипс и т. п.), перо контуров. */
+        Axis, /**< Линия оси, перо контуров. */
+        Label, /**< Надпись, цвет надписей. */
+        RoleCount
+    };
+
+    static constexpr std::uint32_t allRoles = (1u << RoleCount) - 1; /**< Набор из всех ролей. */
+
+    /**
+     * @brief Регистрирует контур.
+     * @param item Элемент сцены.
+     */
+    void addOutline(QAbstractGraphicsShapeItem *item) { items[Outline].push_back(item); }
+
+    /**
+     * @brief Регистрирует линию оси.
+     * @param item Элемент сцены.
+     */
+    void addAxis(QGraphicsLineItem *item) { items[Axis].push_back(item); }
+
+    /**
+     * @brief Регистрирует надпись.
+     * @param item Элемент сцены.
+     */
+    void addLabel(QGraphicsTextItem *item) { items[Label].push_back(item); }
+
+    /**
+     * @brief Возвращает количество элементов роли.
+     * @param role Роль.
+     * @return Количество элементов.
+     */
+    std::size_t size(Role role) const { return items[role].size(); }
+
+    /**
+     * @brief Начинает перекраску элементов в цвета темы.
+     *
+     * Незавершенная перекраска в предыдущую тему прерывается.
+     *
+     * @param theme Тема оформления; должна существовать до завершения перекраски.
+     * @param roles Набор ролей (биты 1 << Role), элементы которых перекрашиваются.
+     */
+    void begin(const Theme &theme, std::uint32_t roles = allRoles);
+
+    /**
+     * @brief Перекрашивает очередную порцию элементов.
+     * @param budget Наибольшее количество элементов за вызов.
+     * @return true, если перекраска завершена.
+     */
+    bool step(std::size_t budget);
+
+    /**
+     * @brief Перекрашивает все элементы сразу.
+     * @param theme Тема оформления.
+     */
+    void apply(const Theme &theme) {
+        begin(theme);
+        step(std::numeric_limits<std::size_t>::max());
+    }
+
+private:
+    /**
+     * @brief Перекрашивает элементы роли в диапазоне индексов.
+     * @param role Роль.
+     * @param first Индекс первого элемента.
+     * @param last Индекс за последним элементом.
+     */
+    void recolor(Role role, std::size_t first, std::size_t last);
+
+    std::array<std::vector<QGraphicsItem *>, RoleCount> items; /**< Элементы по ролям. */
+    const Theme *theme = nullptr; /**< Тема текущей перекраски. */
+    std::uint32_t roles = 0; /**< Роли текущей перекраски. */
+    std::uint32_t role = RoleCount; /**< Роль, перекрашиваемая сейчас. */
+    std::size_t cursor = 0; /**< Индекс следующего элемента роли. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_THEME_H
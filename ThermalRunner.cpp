@@ -0,0 +1,34 @@
+#include "ThermalRunner.h"
+
+#include <chrono>
+
+ThermalRunner::ThermalRunner(const ThermostatConfig &thermostat, const RoomModel &model, double stepSeconds,
+                             double startSeconds, float initialTemperature, int initialSetpoint)
+    : simulation(thermostat, model, stepSeconds, startSeconds), setpoint(initialSetpoint), roomTemperature(initialTemperature) {
+    room.addUnit(initialSetpoint, 0, 0);
+    room.setTemperature(0, initialTemperature);
+    thread = std::thread(&ThermalRunner::run, this);
+}
+
+ThermalRunner::~ThermalRunner() {
+    stopping.store(true);
+    thread.join();
+}
+
+void ThermalRunner::run() {
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(simulation.stepSeconds()));
+    auto next = std::chrono::steady_clock::now();
+    while (!stopping.load()) {
+        room.setSetpoint(0, setpoint.load(std::memory_order_relaxed));
+        UnitMode current = mode.load(std::memory_order_relaxed);
+        room.setPowered(0, current == UnitMode::Cooling || current == UnitMode::Heating);
+        simulation.setDirection(0, current == UnitMode::Heating ? ThermalSimulation::Direction::Heating
+                                                                : ThermalSimulation::Direction::Cooling);
+        simulation.step(room);
+        roomTemperature.store(room.temperature(0), std::memory_order_relaxed);
+
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+}
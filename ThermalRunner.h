@@ -0,0 +1,71 @@
+#ifndef AIRCONDITIONINGCONTROL_THERMALRUNNER_H
+#define AIRCONDITIONINGCONTROL_THERMALRUNNER_H
+
+#include <atomic>
+#include <thread>
+
+#include "PowerStateMachine.h"
+#include "ThermalSimulation.h"
+
+/**
+ * @class ThermalRunner
+ * @brief Моделирование одного помещения в реальном времени в отдельном потоке.
+ *
+ * Поток выполняет шаги ThermalSimulation с периодом, равным шагу модели.
+ * Уставка и режим передаются в поток, а измеренная температура — обратно
+ * через атомарные переменные, поэтому поток интерфейса никогда не ждет
+ * моделирования.
+ */
+class ThermalRunner {
+public:
+    /**
+     * @brief Конструктор класса ThermalRunner; запускает поток моделирования.
+     * @param thermostat Параметры регулятора.
+     * @param model Параметры помещения.
+     * @param stepSeconds Шаг моделирования, с.
+     * @param startSeconds Время суток в момент запуска, с от полуночи.
+     * @param initialTemperature Начальная температура помещения, °C.
+     * @param initialSetpoint Начальная уставка, °C.
+     */
+    ThermalRunner(const ThermostatConfig &thermostat, const RoomModel &model, double stepSeconds,
+                  double startSeconds, float initialTemperature, int initialSetpoint);
+
+    /**
+     * @brief Деструктор класса ThermalRunner; останавливает поток моделирования.
+     */
+    ~ThermalRunner();
+
+    ThermalRunner(const ThermalRunner &) = delete;
+    ThermalRunner &operator=(const ThermalRunner &) = delete;
+
+    void setSetpoint(int value) { setpoint.store(value, std::memory_order_relaxed); }
+
+    /**
+     * @brief Передает режим блока: компрессор работает только в Cooling и Heating,
+     * и выход регулятора ограничивается знаком режима.
+     * @param value Режим работы блока.
+     */
+    void setMode(UnitMode value) { mode.store(value, std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает температуру помещения после последнего шага.
+     * @return Температура, °C.
+     */
+    float temperature() const { return roomTemperature.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Цикл фонового потока.
+     */
+    void run();
+
+    ThermalSimulation simulation; /**< Модель помещения. */
+    FleetStore room; /**< Состояние моделируемого блока. */
+    std::atomic<int> setpoint; /**< Уставка, переданная из интерфейса. */
+    std::atomic<UnitMode> mode{UnitMode::Off}; /**< Режим, переданный из интерфейса. */
+    std::atomic<float> roomTemperature; /**< Температура после последнего шага. */
+    std::atomic<bool> stopping{false}; /**< Запрошена остановка потока. */
+    std::thread thread; /**< Поток моделирования. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_THERMALRUNNER_H
@@ -0,0 +1,97 @@
+#include "ThermalSimulation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+ThermalSimulation::ThermalSimulation(const ThermostatConfig &thermostat, const RoomModel &room, double stepSeconds,
+                                     double startSeconds)
+    : thermostat(thermostat), room(room), dt(stepSeconds), elapsed(startSeconds) {
+}
+
+float ThermalSimulation::outdoorTemperature(double seconds) const {
+    constexpr double day = 24.0 * 3600.0;
+    constexpr double peak = 15.0 * 3600.0;
+    double phase = 2.0 * std::numbers::pi * (seconds - peak) / day;
+    return room.outdoorMean + room.outdoorAmplitude * static_cast<float>(std::cos(phase));
+}
+
+void ThermalSimulation::resize(std::size_t units) {
+    integralColumn.resize(units, 0.0f);
+    lastErrorColumn.resize(units, 0.0f);
+    outputColumn.resize(units, 0.0f);
+    directionColumn.resize(units, static_cast<std::int8_t>(Direction::Any));
+}
+
+void ThermalSimulation::setDirection(FleetStore::UnitId unit, Direction direction) {
+    if (unit >= directionColumn.size())
+        resize(unit + 1);
+    directionColumn[unit] = static_cast<std::int8_t>(direction);
+}
+
+void ThermalSimulation::step(FleetStore &fleet) {
+    if (outputColumn.size() != fleet.size())
+        resize(fleet.size());
+
+    const std::size_t count = fleet.size();
+    const float step = static_cast<float>(dt);
+    const float outdoor = outdoorTemperature(elapsed);
+    const float leak = step / room.timeConstant;
+    const float drive = step * room.capacity;
+
+    std::span<const std::int16_t> setpoints = std::as_const(fleet).setpoints();
+    std::span<const std::uint8_t> power = std::as_const(fleet).powerStates();
+    std::span<float> temperatures = fleet.temperatures();
+    float *integral = integralColumn.data();
+    float *lastError = lastErrorColumn.data();
+    float *output = outputColumn.data();
+    const std::int8_t *direction = directionColumn.data();
+
+    if (thermostat.mode == ThermostatConfig::Mode::Pid) {
+        const float kp = thermostat.kp;
+        const float ki = thermostat.ki;
+        const float kd = thermostat.kd / step;
+        for (std::size_t i = 0; i < count; ++i) {
+            float temperature = temperatures[i];
+            float error = static_cast<float>(setpoints[i]) - temperature;
+            float candidate = integral[i] + error * step;
+            float raw = kp * error + ki * candidate + kd * (error - lastError[i]);
+            float low = direction[i] > 0 ? 0.0f : -1.0f;
+            float high = direction[i] < 0 ? 0.0f : 1.0f;
+            float u = std::clamp(raw, low, high);
+            // Интеграл не накапливается, пока выход упирается в ограничение.
+            integral[i] = raw == u ? candidate : integral[i];
+            lastError[i] = error;
+            u = power[i] ? u : 0.0f;
+            output[i] = u;
+            temperatures[i] = temperature + (outdoor - temperature) * leak + u * drive;
+        }
+    } else {
+        const float band = thermostat.hysteresis;
+        for (std::size_t i = 0; i < count; ++i) {
+            float temperature = temperatures[i];
+            float error = static_cast<float>(setpoints[i]) - temperature;
+            float u = output[i];
+            // Включение за пределами зоны, выключение по достижении уставки.
+            if (error > band)
+                u = 1.0f;
+            else if (error < -band)
+                u = -1.0f;
+            else if (u * error <= 0.0f)
+                u = 0.0f;
+            u = static_cast<float>(direction[i]) * u < 0.0f ? 0.0f : u;
+            u = power[i] ? u : 0.0f;
+            output[i] = u;
+            temperatures[i] = temperature + (outdoor - temperature) * leak + u * drive;
+        }
+    }
+    elapsed += dt;
+}
+
+std::size_t ThermalSimulation::run(FleetStore &fleet, double seconds) {
+    auto steps = static_cast<std::size_t>(std::llround(seconds / dt));
+    for (std::size_t i = 0; i < steps; ++i)
+        step(fleet);
+    return steps;
+}
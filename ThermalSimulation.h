@@ -0,0 +1,145 @@
+#ifndef AIRCONDITIONINGCONTROL_THERMALSIMULATION_H
+#define AIRCONDITIONINGCONTROL_THERMALSIMULATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FleetStore.h"
+
+/**
+ * @struct ThermostatConfig
+ * @brief Параметры регулятора температуры.
+ */
+struct ThermostatConfig {
+    /**
+     * @brief Закон регулирования.
+     */
+    enum class Mode {
+        OnOff, /**< Двухпозиционное регулирование с гистерезисом. */
+        Pid /**< ПИД-регулятор с ограничением интегральной составляющей. */
+    };
+
+    Mode mode = Mode::Pid; /**< Закон регулирования. */
+    float hysteresis = 0.5f; /**< Полуширина зоны гистерезиса, °C. */
+    float kp = 0.5f; /**< Пропорциональный коэффициент, 1/°C. */
+    float ki = 0.001f; /**< Интегральный коэффициент, 1/(°C·с). */
+    float kd = 0.0f; /**< Дифференциальный коэффициент, с/°C. */
+};
+
+/**
+ * @struct RoomModel
+ * @brief Параметры тепловой модели помещения первого порядка.
+ *
+ * dT/dt = (Tнаруж(t) - T) / timeConstant + u * capacity, где u ∈ [-1, 1] —
+ * выход регулятора (отрицательный — охлаждение). Наружная температура
+ * меняется по синусоиде с суточным периодом и максимумом в 15:00.
+ */
+struct RoomModel {
+    float outdoorMean = 26.0f; /**< Среднесуточная наружная температура, °C. */
+    float outdoorAmplitude = 6.0f; /**< Амплитуда суточного колебания, °C. */
+    float timeConstant = 3600.0f; /**< Постоянная времени теплообмена с улицей, с. */
+    float capacity = 0.01f; /**< Скорость изменения температуры при полной мощности, °C/с. */
+};
+
+/**
+ * @class ThermalSimulation
+ * @brief Детерминированное моделирование помещений парка с фиксированным шагом.
+ *
+ * Состояние регуляторов хранится столбцами, как и FleetStore, а шаг
+ * выполняется одним проходом по всем блокам: читаются уставки и питание,
+ * обновляется измеренная температура. Результат зависит только от
+ * начального состояния и количества шагов, поэтому моделирование в
+ * реальном времени и в пакетном режиме совпадает.
+ */
+class ThermalSimulation {
+public:
+    /**
+     * @brief Допустимый знак выхода регулятора блока.
+     */
+    enum class Direction : std::int8_t {
+        Cooling = -1, /**< Только охлаждение: выход в [-1, 0]. */
+        Any = 0, /**< Охлаждение и обогрев: выход в [-1, 1]. */
+        Heating = 1 /**< Только обогрев: выход в [0, 1]. */
+    };
+
+    /**
+     * @brief Конструктор класса ThermalSimulation.
+     * @param thermostat Параметры регулятора.
+     * @param room Параметры помещения.
+     * @param stepSeconds Шаг моделирования, с.
+     * @param startSeconds Время суток в начале моделирования, с от полуночи.
+     */
+    ThermalSimulation(const ThermostatConfig &thermostat, const RoomModel &room, double stepSeconds,
+                      double startSeconds = 0);
+
+    /**
+     * @brief Ограничивает знак выхода регулятора блока.
+     *
+     * Компрессор в режиме охлаждения не может греть, и наоборот, поэтому
+     * выход регулятора ограничивается режимом, выбранным автоматом режимов.
+     * По умолчанию выход блока не ограничен.
+     *
+     * @param unit Индекс блока.
+     * @param direction Допустимый знак выхода.
+     */
+    void setDirection(FleetStore::UnitId unit, Direction direction);
+
+    /**
+     * @brief Выполняет один шаг моделирования для всех блоков парка.
+     * @param fleet Хранилище состояния блоков.
+     */
+    void step(FleetStore &fleet);
+
+    /**
+     * @brief Выполняет моделирование на заданный интервал.
+     * @param fleet Хранилище состояния блоков.
+     * @param seconds Длительность моделирования, с.
+     * @return Количество выполненных шагов.
+     */
+    std::size_t run(FleetStore &fleet, double seconds);
+
+    /**
+     * @brief Возвращает текущее модельное время.
+     * @return Время от полуночи первых суток, с.
+     */
+    double time() const { return elapsed; }
+
+    /**
+     * @brief Возвращает шаг моделирования.
+     * @return Шаг, с.
+     */
+    double stepSeconds() const { return dt; }
+
+    /**
+     * @brief Возвращает наружную температуру в заданный момент.
+     * @param seconds Время от полуночи, с.
+     * @return Наружная температура, °C.
+     */
+    float outdoorTemperature(double seconds) const;
+
+    /**
+     * @brief Возвращает последний выход регулятора блока.
+     * @param unit Индекс блока.
+     * @return Выход в диапазоне [-1, 1]; отрицательный — охлаждение.
+     */
+    float output(FleetStore::UnitId unit) const { return outputColumn[unit]; }
+
+private:
+    /**
+     * @brief Создает состояние регуляторов для новых блоков парка.
+     * @param units Количество блоков.
+     */
+    void resize(std::size_t units);
+
+    ThermostatConfig thermostat; /**< Параметры регулятора. */
+    RoomModel room; /**< Параметры помещения. */
+    double dt; /**< Шаг моделирования, с. */
+    double elapsed; /**< Модельное время, с. */
+    std::vector<float> integralColumn; /**< Интеграл ошибки ПИД-регулятора. */
+    std::vector<float> lastErrorColumn; /**< Ошибка на предыдущем шаге. */
+    std::vector<float> outputColumn; /**< Выход регулятора. */
+    std::vector<std::int8_t> directionColumn; /**< Допустимый знак выхода (Direction). */
+};
+
+#endif //AIRCONDITIONINGCONTROL_THERMALSIMULATION_H
@@ -0,0 +1,137 @@
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Событие трассы в буфере.
+ */
+struct TraceEvent {
+    const char *name = nullptr; /**< Имя события. */
+    const char *category = nullptr; /**< Категория события. */
+    const char *argument = nullptr; /**< Имя аргумента мгновенного события. */
+    double value = 0; /**< Значение аргумента мгновенного события. */
+    std::int64_t beginNs = 0; /**< Начало от старта записи, нс. */
+    std::int64_t durationNs = -1; /**< Длительность, нс (-1 — мгновенное событие). */
+    std::uint32_t thread = 0; /**< Номер потока. */
+};
+
+std::mutex bufferMutex;
+std::vector<TraceEvent> events; // Кольцевой буфер; следующая запись идет в events[written % size].
+std::uint64_t written = 0;
+TraceRecorder::Clock::time_point origin;
+std::vector<const char *> threadNames;
+std::atomic<std::uint32_t> nextThread{0};
+thread_local std::uint32_t currentThread = UINT32_MAX;
+
+std::uint32_t threadId() {
+    if (currentThread == UINT32_MAX)
+        currentThread = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return currentThread;
+}
+
+void push(const TraceEvent &event) {
+    std::lock_guard lock(bufferMutex);
+    if (events.empty())
+        return;
+    events[written % events.size()] = event;
+    ++written;
+}
+
+} // namespace
+
+std::atomic<bool> TraceRecorder::enabledFlag{false};
+
+void TraceRecorder::start(std::size_t capacity) {
+    std::lock_guard lock(bufferMutex);
+    events.assign(std::max<std::size_t>(1, capacity), TraceEvent{});
+    written = 0;
+    origin = Clock::now();
+    enabledFlag.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::setThreadName(const char *name) {
+    std::uint32_t thread = threadId();
+    std::lock_guard lock(bufferMutex);
+    if (threadNames.size() <= thread)
+        threadNames.resize(thread + 1, nullptr);
+    threadNames[thread] = name;
+}
+
+void TraceRecorder::complete(const char *name, const char *category, Clock::time_point begin, Clock::time_point end) {
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.beginNs = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - origin).count();
+    event.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    event.thread = threadId();
+    push(event);
+}
+
+void TraceRecorder::instant(const char *name, const char *category, const char *argument, double value) {
+    if (!enabled())
+        return;
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.argument = argument;
+    event.value = value;
+    event.beginNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();
+    event.thread = threadId();
+    push(event);
+}
+
+std::uint64_t TraceRecorder::dropped() {
+    std::lock_guard lock(bufferMutex);
+    return written > events.size() ? written - events.size() : 0;
+}
+
+bool TraceRecorder::write(const std::string &path) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+        return false;
+
+    std::lock_guard lock(bufferMutex);
+    char line[512];
+    const char *separator = "\n";
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (std::size_t thread = 0; thread < threadNames.size(); ++thread) {
+        if (!threadNames[thread])
+            continue;
+        std::snprintf(line, sizeof(line),
+                      "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":\"%s\"}}",
+                      separator, thread, threadNames[thread]);
+        file << line;
+        separator = ",\n";
+    }
+
+    std::uint64_t first = written > events.size() ? written - events.size() : 0;
+    for (std::uint64_t index = first; index < written; ++index) {
+        const TraceEvent &event = events[index % events.size()];
+        double beginUs = static_cast<double>(event.beginNs) / 1e3;
+        if (event.durationNs >= 0) {
+            std::snprintf(line, sizeof(line),
+                          "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                          separator, event.name, event.category, beginUs,
+                          static_cast<double>(event.durationNs) / 1e3, event.thread);
+        } else if (event.argument) {
+            std::snprintf(line, sizeof(line),
+                          "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,"
+                          "\"args\":{\"%s\":%g}}",
+                          separator, event.name, event.category, beginUs, event.thread, event.argument, event.value);
+        } else {
+            std::snprintf(line, sizeof(line),
+                          "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                          separator, event.name, event.category, beginUs, event.thread);
+        }
+        file << line;
+        separator = ",\n";
+    }
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
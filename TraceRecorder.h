@@ -0,0 +1,120 @@
+#ifndef AIRCONDITIONINGCONTROL_TRACERECORDER_H
+#define AIRCONDITIONINGCONTROL_TRACERECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class TraceRecorder
+ * @brief Запись событий в формате Trace Event JSON для chrome://tracing и Perfetto.
+ *
+ * События хранятся в кольцевом буфере фиксированной емкости, выделенном при
+ * start(): при переполнении перезаписываются самые старые, поэтому память
+ * ограничена, а в файл попадают последние секунды перед выходом — как раз
+ * то, что нужно для разбора замеченного оператором подергивания. Запись
+ * события — захват незанятой блокировки и копирование записи фиксированного
+ * размера; пока запись выключена, она сводится к чтению атомарного флага.
+ *
+ * Имена и категории событий и потоков хранятся указателями и должны быть
+ * строковыми литералами без кавычек и обратной косой черты.
+ */
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t defaultCapacity = 1u << 18; /**< Событий в буфере по умолчанию (~12 МБ). */
+
+    /**
+     * @brief Выделяет буфер и включает запись событий.
+     * @param capacity Емкость буфера, событий.
+     */
+    static void start(std::size_t capacity = defaultCapacity);
+
+    /**
+     * @brief Выключает запись событий; накопленные события сохраняются до write().
+     */
+    static void stop() noexcept { enabledFlag.store(false, std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает, включена ли запись событий.
+     * @return true, если запись включена.
+     */
+    static bool enabled() noexcept { return enabledFlag.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Задает имя текущего потока в трассе.
+     * @param name Имя потока.
+     */
+    static void setThreadName(const char *name);
+
+    /**
+     * @brief Записывает событие с длительностью (фаза "X").
+     * @param name Имя события.
+     * @param category Категория события.
+     * @param begin Время начала.
+     * @param end Время окончания.
+     */
+    static void complete(const char *name, const char *category, Clock::time_point begin, Clock::time_point end);
+
+    /**
+     * @brief Записывает мгновенное событие (фаза "i") с необязательным числовым аргументом.
+     * @param name Имя события.
+     * @param category Категория события.
+     * @param argument Имя аргумента или nullptr.
+     * @param value Значение аргумента.
+     */
+    static void instant(const char *name, const char *category, const char *argument = nullptr, double value = 0);
+
+    /**
+     * @brief Возвращает количество событий, перезаписанных при переполнении буфера.
+     * @return Количество потерянных событий.
+     */
+    static std::uint64_t dropped();
+
+    /**
+     * @brief Записывает накопленные события в файл Trace Event JSON.
+     * @param path Путь к файлу.
+     * @return true, если файл записан.
+     */
+    static bool write(const std::string &path);
+
+private:
+    static std::atomic<bool> enabledFlag; /**< Включена ли запись событий. */
+};
+
+/**
+ * @class TraceScope
+ * @brief Записывает область видимости как событие с длительностью.
+ */
+class TraceScope {
+public:
+    /**
+     * @brief Конструктор класса TraceScope.
+     * @param name Имя события.
+     * @param category Категория события.
+     */
+    TraceScope(const char *name, const char *category) noexcept
+        : name(name), category(category), active(TraceRecorder::enabled()) {
+        if (active)
+            begin = TraceRecorder::Clock::now();
+    }
+
+    ~TraceScope() {
+        if (active)
+            TraceRecorder::complete(name, category, begin, TraceRecorder::Clock::now());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *name; /**< Имя события. */
+    const char *category; /**< Категория события. */
+    bool active; /**< Была ли запись включена при входе. */
+    TraceRecorder::Clock::time_point begin; /**< Время входа. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_TRACERECORDER_H
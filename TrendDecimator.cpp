@@ -0,0 +1,31 @@
+#include "TrendDecimator.h"
+
+#include <algorithm>
+
+std::size_t decimateTrend(std::span<const TelemetrySample> samples, float TelemetrySample::*field,
+                          std::int64_t startMs, std::int64_t endMs, std::span<TrendColumn> columns) {
+    std::ranges::fill(columns, TrendColumn{});
+    if (columns.empty() || endMs <= startMs)
+        return 0;
+
+    std::size_t filled = 0;
+    const std::int64_t span = endMs - startMs;
+    const auto count = static_cast<std::int64_t>(columns.size());
+    // Порядок отсчетов не проверяется: отсчет вне окна пропускается, а не дает индекс за пределами columns.
+    for (const TelemetrySample &sample: samples) {
+        if (sample.timestampMs < startMs || sample.timestampMs >= endMs)
+            continue;
+        auto index = static_cast<std::size_t>((sample.timestampMs - startMs) * count / span);
+        TrendColumn &column = columns[index];
+        float value = sample.*field;
+        if (column.empty) {
+            column.min = column.max = value;
+            column.empty = false;
+            ++filled;
+        } else {
+            column.min = std::min(column.min, value);
+            column.max = std::max(column.max, value);
+        }
+    }
+    return filled;
+}
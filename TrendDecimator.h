@@ -0,0 +1,39 @@
+#ifndef AIRCONDITIONINGCONTROL_TRENDDECIMATOR_H
+#define AIRCONDITIONINGCONTROL_TRENDDECIMATOR_H
+
+#include <cstdint>
+#include <span>
+
+#include "TelemetryRing.h"
+
+/**
+ * @struct TrendColumn
+ * @brief Диапазон значений, попавших в один столбец пикселей графика.
+ */
+struct TrendColumn {
+    float min = 0; /**< Минимальное значение в столбце. */
+    float max = 0; /**< Максимальное значение в столбце. */
+    bool empty = true; /**< В столбец не попало ни одного отсчета. */
+
+    bool operator==(const TrendColumn &) const = default;
+};
+
+/**
+ * @brief Прореживает отсчеты до минимума и максимума на столбец пикселей.
+ *
+ * Окно времени [startMs, endMs) делится на columns.size() равных столбцов.
+ * Один проход по отсчетам за O(n) без выделения памяти; результат содержит
+ * не больше двух точек на столбец независимо от количества отсчетов, при
+ * этом кратковременные выбросы не теряются.
+ *
+ * @param samples Отсчеты; отсчеты вне окна пропускаются, порядок не важен.
+ * @param field Поле отсчета, по которому строится график.
+ * @param startMs Начало окна времени, мс.
+ * @param endMs Конец окна времени, мс.
+ * @param columns Столбцы результата.
+ * @return Количество непустых столбцов.
+ */
+std::size_t decimateTrend(std::span<const TelemetrySample> samples, float TelemetrySample::*field,
+                          std::int64_t startMs, std::int64_t endMs, std::span<TrendColumn> columns);
+
+#endif //AIRCONDITIONINGCONTROL_TRENDDECIMATOR_H
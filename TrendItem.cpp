@@ -0,0 +1,45 @@
+#include "TrendItem.h"
+
+#include <QPainterPath>
+
+#include <algorithm>
+#include <cmath>
+
+TrendItem::TrendItem(const QRectF &area, float minValue, float maxValue, QGraphicsItem *parent)
+    : QGraphicsPathItem(parent), area(area), minValue(minValue), maxValue(maxValue),
+      columns(std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(area.width())))),
+      renderedColumns(columns.size()) {
+}
+
+bool TrendItem::setSamples(std::span<const TelemetrySample> samples, float TelemetrySample::*field,
+                           qint64 startMs, qint64 endMs) {
+    std::size_t filled = decimateTrend(samples, field, startMs, endMs, columns);
+    if (columns == renderedColumns)
+        return false;
+
+    QPainterPath trend;
+    trend.reserve(static_cast<int>(filled * 2));
+    const qreal columnWidth = area.width() / static_cast<qreal>(columns.size());
+    bool first = true;
+    for (std::size_t index = 0; index < columns.size(); ++index) {
+        const TrendColumn &column = columns[index];
+        if (column.empty)
+            continue;
+        qreal x = area.left() + (static_cast<qreal>(index) + 0.5) * columnWidth;
+        if (first) {
+            trend.moveTo(x, valueToY(column.max));
+            first = false;
+        } else {
+            trend.lineTo(x, valueToY(column.max));
+        }
+        trend.lineTo(x, valueToY(column.min));
+    }
+    setPath(trend);
+    columns.swap(renderedColumns);
+    return true;
+}
+
+qreal TrendItem::valueToY(float value) const {
+    float ratio = (std::clamp(value, minValue, maxValue) - minValue) / (maxValue - minValue);
+    return area.bottom() - ratio * area.height();
+}
@@ -0,0 +1,64 @@
+#ifndef AIRCONDITIONINGCONTROL_TRENDITEM_H
+#define AIRCONDITIONINGCONTROL_TRENDITEM_H
+
+#include <QGraphicsPathItem>
+
+#include <span>
+#include <vector>
+
+#include "TrendDecimator.h"
+
+/**
+ * @class TrendItem
+ * @brief Бегущий график показаний, построенный одним элементом сцены.
+ *
+ * Отсчеты прореживаются до минимума и максимума на столбец пикселей, и весь
+ * график собирается в один QPainterPath, поэтому стоимость отрисовки зависит
+ * от ширины графика, а не от количества отсчетов. Если после прореживания
+ * столбцы совпали с уже показанными, путь не заменяется и сцена не
+ * перерисовывает график.
+ */
+class TrendItem : public QGraphicsPathItem {
+public:
+    /**
+     * @brief Конструктор класса TrendItem.
+     * @param area Область графика в координатах родителя.
+     * @param minValue Значение, соответствующее нижней границе области.
+     * @param maxValue Значение, соответствующее верхней границе области.
+     * @param parent Указатель на родительский элемент.
+     */
+    TrendItem(const QRectF &area, float minValue, float maxValue, QGraphicsItem *parent = nullptr);
+
+    /**
+     * @brief Перестраивает график по отсчетам в окне времени.
+     * @param samples Отсчеты, упорядоченные по времени.
+     * @param field Поле отсчета, по которому строится график.
+     * @param startMs Начало окна времени (левый край), мс.
+     * @param endMs Конец окна времени (правый край), мс.
+     * @return true, если изображение графика изменилось.
+     */
+    bool setSamples(std::span<const TelemetrySample> samples, float TelemetrySample::*field,
+                    qint64 startMs, qint64 endMs);
+
+    /**
+     * @brief Возвращает количество столбцов графика.
+     * @return Количество столбцов (по одному на пиксель ширины).
+     */
+    std::size_t columnCount() const { return columns.size(); }
+
+private:
+    /**
+     * @brief Переводит значение в координату Y внутри области графика.
+     * @param value Значение.
+     * @return Координата Y.
+     */
+    qreal valueToY(float value) const;
+
+    QRectF area; /**< Область графика. */
+    float minValue; /**< Значение нижней границы. */
+    float maxValue; /**< Значение верхней границы. */
+    std::vector<TrendColumn> columns; /**< Столбцы прореживания, по одному на пиксель ширины. */
+    std::vector<TrendColumn> renderedColumns; /**< Столбцы, по которым построен текущий путь. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_TRENDITEM_H
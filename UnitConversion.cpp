@@ -0,0 +1,125 @@
+#include "UnitConversion.h"
+#include "Units.h"
+
+#include <cstddef>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AIRCONDITIONING_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Скалярная реализация convertAffine.
+ */
+static void convertAffineScalar(const float *in, float *out, std::size_t count, float scale, float offset) {
+    for (std::size_t i = 0; i < count; ++i) {
+        float scaled = in[i] * scale;
+        out[i] = scaled + offset;
+    }
+}
+
+#ifdef AIRCONDITIONING_X86_KERNELS
+
+/**
+ * @brief Реализация convertAffine на SSE2.
+ */
+__attribute__((target("sse2")))
+static void convertAffineSse2(const float *in, float *out, std::size_t count, float scale, float offset) {
+    const __m128 scaleVector = _mm_set1_ps(scale);
+    const __m128 offsetVector = _mm_set1_ps(offset);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 value = _mm_loadu_ps(in + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(value, scaleVector), offsetVector));
+    }
+    convertAffineScalar(in + i, out + i, count - i, scale, offset);
+}
+
+/**
+ * @brief Реализация convertAffine на AVX2.
+ */
+__attribute__((target("avx2")))
+static void convertAffineAvx2(const float *in, float *out, std::size_t count, float scale, float offset) {
+    const __m256 scaleVector = _mm256_set1_ps(scale);
+    const __m256 offsetVector = _mm256_set1_ps(offset);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 first = _mm256_loadu_ps(in + i);
+        __m256 second = _mm256_loadu_ps(in + i + 8);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(first, scaleVector), offsetVector));
+        _mm256_storeu_ps(out + i + 8, _mm256_add_ps(_mm256_mul_ps(second, scaleVector), offsetVector));
+    }
+    for (; i + 8 <= count; i += 8) {
+        __m256 value = _mm256_loadu_ps(in + i);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(value, scaleVector), offsetVector));
+    }
+    convertAffineScalar(in + i, out + i, count - i, scale, offset);
+}
+
+#endif
+
+bool isConversionKernelSupported(ConversionKernel kernel) {
+    switch (kernel) {
+        case ConversionKernel::Auto:
+        case ConversionKernel::Scalar:
+            return true;
+#ifdef AIRCONDITIONING_X86_KERNELS
+        case ConversionKernel::Sse2:
+            return __builtin_cpu_supports("sse2");
+        case ConversionKernel::Avx2:
+            return __builtin_cpu_supports("avx2");
+#else
+        case ConversionKernel::Sse2:
+        case ConversionKernel::Avx2:
+            return false;
+#endif
+    }
+    return false;
+}
+
+ConversionKernel bestConversionKernel() {
+    static const ConversionKernel best = [] {
+        if (isConversionKernelSupported(ConversionKernel::Avx2))
+            return ConversionKernel::Avx2;
+        if (isConversionKernelSupported(ConversionKernel::Sse2))
+            return ConversionKernel::Sse2;
+        return ConversionKernel::Scalar;
+    }();
+    return best;
+}
+
+void convertAffine(std::span<const float> in, std::span<float> out, float scale, float offset,
+                   ConversionKernel kernel) {
+    if (kernel == ConversionKernel::Auto)
+        kernel = bestConversionKernel();
+    else if (!isConversionKernelSupported(kernel))
+        kernel = ConversionKernel::Scalar;
+
+    switch (kernel) {
+#ifdef AIRCONDITIONING_X86_KERNELS
+        case ConversionKernel::Avx2:
+            convertAffineAvx2(in.data(), out.data(), in.size(), scale, offset);
+            return;
+        case ConversionKernel::Sse2:
+            convertAffineSse2(in.data(), out.data(), in.size(), scale, offset);
+            return;
+#endif
+        default:
+            convertAffineScalar(in.data(), out.data(), in.size(), scale, offset);
+            return;
+    }
+}
+
+void convertTemperatures(std::span<const float> celsius, std::span<float> out, TemperatureUnit unit,
+                         ConversionKernel kernel) {
+    visitTemperatureUnit(unit, [&](auto to) {
+        convertBatch<Celsius, decltype(to)>(celsius, out, kernel);
+    });
+}
+
+void convertPressures(std::span<const float> pascal, std::span<float> out, PressureUnit unit,
+                      ConversionKernel kernel) {
+    visitPressureUnit(unit, [&](auto to) {
+        convertBatch<Pascal, decltype(to)>(pascal, out, kernel);
+    });
+}
@@ -0,0 +1,81 @@
+#ifndef AIRCONDITIONINGCONTROL_UNITCONVERSION_H
+#define AIRCONDITIONINGCONTROL_UNITCONVERSION_H
+
+#include <span>
+
+/**
+ * @brief Единицы измерения температуры; значения совпадают с индексами выпадающего списка.
+ */
+enum class TemperatureUnit {
+    Celsius = 0,
+    Kelvin = 1,
+    Fahrenheit = 2
+};
+
+/**
+ * @brief Единицы измерения давления; значения совпадают с индексами выпадающего списка.
+ */
+enum class PressureUnit {
+    Pascal = 0,
+    MmHg = 1
+};
+
+/**
+ * @brief Реализация пакетного преобразования.
+ */
+enum class ConversionKernel {
+    Auto, /**< Лучшая реализация, поддерживаемая процессором. */
+    Scalar, /**< Переносимый скалярный цикл. */
+    Sse2, /**< SSE2, 4 значения за операцию. */
+    Avx2 /**< AVX2, 8 значений за операцию. */
+};
+
+/**
+ * @brief Возвращает реализацию, которую выбирает ConversionKernel::Auto на этом процессоре.
+ * @return Реализация пакетного преобразования.
+ */
+ConversionKernel bestConversionKernel();
+
+/**
+ * @brief Проверяет, поддерживает ли процессор реализацию.
+ * @param kernel Реализация пакетного преобразования.
+ * @return true, если реализацию можно использовать.
+ */
+bool isConversionKernelSupported(ConversionKernel kernel);
+
+/**
+ * @brief Вычисляет out[i] = in[i] * scale + offset для всего массива.
+ *
+ * Все реализации выполняют умножение и сложение раздельно (без FMA), поэтому
+ * результаты совпадают побитово независимо от выбранной реализации.
+ *
+ * @param in Исходные значения.
+ * @param out Результат; размер не меньше in.size(). Допускается out == in.
+ * @param scale Множитель.
+ * @param offset Смещение.
+ * @param kernel Реализация; неподдерживаемая заменяется скалярной.
+ */
+void convertAffine(std::span<const float> in, std::span<float> out, float scale, float offset,
+                   ConversionKernel kernel = ConversionKernel::Auto);
+
+/**
+ * @brief Пакетно переводит температуры из °C в заданные единицы.
+ * @param celsius Температуры, °C.
+ * @param out Результат; размер не меньше celsius.size().
+ * @param unit Единицы результата.
+ * @param kernel Реализация пакетного преобразования.
+ */
+void convertTemperatures(std::span<const float> celsius, std::span<float> out, TemperatureUnit unit,
+                         ConversionKernel kernel = ConversionKernel::Auto);
+
+/**
+ * @brief Пакетно переводит давления из Па в заданные единицы.
+ * @param pascal Давления, Па.
+ * @param out Результат; размер не меньше pascal.size().
+ * @param unit Единицы результата.
+ * @param kernel Реализация пакетного преобразования.
+ */
+void convertPressures(std::span<const float> pascal, std::span<float> out, PressureUnit unit,
+                      ConversionKernel kernel = ConversionKernel::Auto);
+
+#endif //AIRCONDITIONINGCONTROL_UNITCONVERSION_H
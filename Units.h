@@ -0,0 +1,163 @@
+#ifndef AIRCONDITIONINGCONTROL_UNITS_H
+#define AIRCONDITIONINGCONTROL_UNITS_H
+
+#include <span>
+#include <type_traits>
+
+#include "UnitConversion.h"
+
+/**
+ * @brief Размерность температуры.
+ */
+struct TemperatureDimension {
+};
+
+/**
+ * @brief Размерность давления.
+ */
+struct PressureDimension {
+};
+
+/*
+ * Единица измерения задается линейным преобразованием из базовой единицы
+ * своей размерности: значение = базовое * scale + offset. Базовые единицы —
+ * °C и Па, в них хранятся значения в FleetStore.
+ */
+
+struct Celsius {
+    using Dimension = TemperatureDimension;
+    static constexpr double scale = 1.0;
+    static constexpr double offset = 0.0;
+    static constexpr const char *suffix = "°C";
+};
+
+struct Kelvin {
+    using Dimension = TemperatureDimension;
+    static constexpr double scale = 1.0;
+    static constexpr double offset = 273.15;
+    static constexpr const char *suffix = " K";
+};
+
+struct Fahrenheit {
+    using Dimension = TemperatureDimension;
+    static constexpr double scale = 9.0 / 5.0;
+    static constexpr double offset = 32.0;
+    static constexpr const char *suffix = "°F";
+};
+
+struct Pascal {
+    using Dimension = PressureDimension;
+    static constexpr double scale = 1.0;
+    static constexpr double offset = 0.0;
+    static constexpr const char *suffix = " Па";
+};
+
+struct MmHg {
+    using Dimension = PressureDimension;
+    static constexpr double scale = 0.00750062;
+    static constexpr double offset = 0.0;
+    static constexpr const char *suffix = " мм рт. ст.";
+};
+
+/**
+ * @class Quantity
+ * @brief Значение величины с единицей измерения, известной на этапе компиляции.
+ */
+template<typename Unit>
+class Quantity {
+public:
+    using UnitType = Unit;
+
+    constexpr Quantity() = default;
+
+    constexpr explicit Quantity(double value) : amount(value) {}
+
+    /**
+     * @brief Возвращает численное значение в единицах Unit.
+     * @return Численное значение.
+     */
+    constexpr double count() const { return amount; }
+
+private:
+    double amount = 0.0; /**< Численное значение. */
+};
+
+/**
+ * @struct AffineConversion
+ * @brief Преобразование между двумя единицами одной размерности: to = from * scale + offset.
+ */
+template<typename From, typename To>
+struct AffineConversion {
+    static_assert(std::is_same_v<typename From::Dimension, typename To::Dimension>,
+                  "Преобразование между единицами разных размерностей");
+
+    static constexpr double scale = To::scale / From::scale;
+    static constexpr double offset = To::offset - From::offset * To::scale / From::scale;
+};
+
+/**
+ * @brief Переводит величину в другие единицы той же размерности.
+ * @param quantity Исходная величина.
+ * @return Величина в единицах To.
+ */
+template<typename To, typename From>
+constexpr Quantity<To> quantityCast(Quantity<From> quantity) {
+    using Conversion = AffineConversion<From, To>;
+    if constexpr (std::is_same_v<From, To>)
+        return quantity;
+    else
+        return Quantity<To>(quantity.count() * Conversion::scale + Conversion::offset);
+}
+
+/**
+ * @brief Пакетно переводит значения между единицами, известными на этапе компиляции.
+ * @param in Значения в единицах From.
+ * @param out Результат в единицах To; размер не меньше in.size().
+ * @param kernel Реализация пакетного преобразования.
+ */
+template<typename From, typename To>
+void convertBatch(std::span<const float> in, std::span<float> out, ConversionKernel kernel = ConversionKernel::Auto) {
+    using Conversion = AffineConversion<From, To>;
+    convertAffine(in, out, static_cast<float>(Conversion::scale), static_cast<float>(Conversion::offset), kernel);
+}
+
+/**
+ * @brief Выбирает тип единицы температуры по значению перечисления один раз и вызывает функцию.
+ * @param unit Единицы измерения.
+ * @param function Функция, принимающая пустой объект типа единицы (Celsius, Kelvin или Fahrenheit).
+ * @return Результат функции.
+ */
+template<typename Function>
+decltype(auto) visitTemperatureUnit(TemperatureUnit unit, Function &&function) {
+    switch (unit) {
+        case TemperatureUnit::Kelvin:
+            return function(Kelvin());
+        case TemperatureUnit::Fahrenheit:
+            return function(Fahrenheit());
+        case TemperatureUnit::Celsius:
+        default:
+            return function(Celsius());
+    }
+}
+
+/**
+ * @brief Выбирает тип единицы давления по значению перечисления один раз и вызывает функцию.
+ * @param unit Единицы измерения.
+ * @param function Функция, принимающая пустой объект типа единицы (Pascal или MmHg).
+ * @return Результат функции.
+ */
+template<typename Function>
+decltype(auto) visitPressureUnit(PressureUnit unit, Function &&function) {
+    switch (unit) {
+        case PressureUnit::MmHg:
+            return function(MmHg());
+        case PressureUnit::Pascal:
+        default:
+            return function(Pascal());
+    }
+}
+
+static_assert(quantityCast<Kelvin>(Quantity<Celsius>(0.0)).count() == 273.15);
+static_assert(quantityCast<Celsius>(quantityCast<Fahrenheit>(Quantity<Celsius>(100.0))).count() == 100.0);
+
+#endif //AIRCONDITIONINGCONTROL_UNITS_H
@@ -0,0 +1,80 @@
+#ifndef AIRCONDITIONINGCONTROL_UPDATESCHEDULER_H
+#define AIRCONDITIONINGCONTROL_UPDATESCHEDULER_H
+
+#include <cstdint>
+
+/**
+ * @class UpdateScheduler
+ * @brief Накопитель отложенных обновлений отображения.
+ *
+ * Изменения состояния только помечают части отображения как устаревшие;
+ * сами части перерисовываются не чаще одного раза за кадр, сколько бы
+ * изменений ни пришло между кадрами.
+ */
+class UpdateScheduler {
+public:
+    /**
+     * @brief Части отображения, обновляемые независимо.
+     */
+    enum Part : std::uint32_t {
+        Temperature = 1u << 0,
+        Pressure = 1u << 1,
+        Humidity = 1u << 2,
+        Power = 1u << 3,
+        Airflow = 1u << 4,
+        Mode = 1u << 5
+    };
+
+    /**
+     * @brief Помечает части отображения как устаревшие.
+     * @param parts Набор флагов Part.
+     * @return true, если до вызова ожидающих обновлений не было и кадр нужно запланировать.
+     */
+    bool markDirty(std::uint32_t parts) {
+        bool wasIdle = dirty == 0;
+        std::uint32_t repeated = dirty & parts;
+        for (; repeated != 0; repeated &= repeated - 1)
+            ++coalesced;
+        dirty |= parts;
+        ++requested;
+        return wasIdle;
+    }
+
+    /**
+     * @brief Забирает набор устаревших частей и сбрасывает его.
+     * @return Набор флагов Part.
+     */
+    std::uint32_t takeDirty() {
+        std::uint32_t parts = dirty;
+        dirty = 0;
+        if (parts != 0)
+            ++frames;
+        return parts;
+    }
+
+    /**
+     * @brief Возвращает количество обновлений, объединенных с уже ожидающими.
+     * @return Количество объединенных обновлений.
+     */
+    std::uint64_t coalescedUpdates() const { return coalesced; }
+
+    /**
+     * @brief Возвращает количество запрошенных обновлений.
+     * @return Количество вызовов markDirty().
+     */
+    std::uint64_t requestedUpdates() const { return requested; }
+
+    /**
+     * @brief Возвращает количество выполненных кадров обновления.
+     * @return Количество кадров.
+     */
+    std::uint64_t appliedFrames() const { return frames; }
+
+private:
+    std::uint32_t dirty = 0; /**< Набор устаревших частей. */
+    std::uint64_t coalesced = 0; /**< Количество объединенных обновлений. */
+    std::uint64_t requested = 0; /**< Количество запрошенных обновлений. */
+    std::uint64_t frames = 0; /**< Количество выполненных кадров. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_UPDATESCHEDULER_H
@@ -0,0 +1,47 @@
+#include "ValueFormatter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+/**
+ * @brief Копирует текст в буфер, обрезая его по границе буфера.
+ * @param first Текущая позиция в буфере.
+ * @param last Конец буфера.
+ * @param text Текст.
+ * @return Позиция после скопированного текста.
+ */
+static char *append(char *first, char *last, std::string_view text) {
+    std::size_t size = std::min<std::size_t>(text.size(), last - first);
+    std::memcpy(first, text.data(), size);
+    return first + size;
+}
+
+bool ValueFormatter::format(std::string_view prefix, double value, std::string_view suffix) {
+    std::array<char, capacity> scratch;
+    char *last = scratch.data() + scratch.size();
+    char *position = append(scratch.data(), last, prefix);
+    auto [end, error] = std::to_chars(position, last, value, std::chars_format::general, 6);
+    position = error == std::errc() ? end : position;
+    position = append(position, last, suffix);
+    return commit(scratch, position - scratch.data());
+}
+
+bool ValueFormatter::format(std::string_view prefix, long long value, std::string_view suffix) {
+    std::array<char, capacity> scratch;
+    char *last = scratch.data() + scratch.size();
+    char *position = append(scratch.data(), last, prefix);
+    auto [end, error] = std::to_chars(position, last, value);
+    position = error == std::errc() ? end : position;
+    position = append(position, last, suffix);
+    return commit(scratch, position - scratch.data());
+}
+
+bool ValueFormatter::commit(const std::array<char, capacity> &scratch, std::size_t size) {
+    if (initialized && size == length && std::memcmp(scratch.data(), current.data(), size) == 0)
+        return false;
+    std::memcpy(current.data(), scratch.data(), size);
+    length = size;
+    initialized = true;
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef AIRCONDITIONINGCONTROL_VALUEFORMATTER_H
+#define AIRCONDITIONINGCONTROL_VALUEFORMATTER_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @class ValueFormatter
+ * @brief Форматирование подписи "префикс число суффикс" в буфер фиксированного размера.
+ *
+ * Текст собирается std::to_chars во внутренний буфер без выделения памяти и
+ * сравнивается с предыдущим. Вызывающий код обновляет элемент интерфейса
+ * только если format() вернул true, поэтому повторные обновления с тем же
+ * видимым текстом не создают строк Qt и не вызывают перерисовку.
+ */
+class ValueFormatter {
+public:
+    static constexpr std::size_t capacity = 128; /**< Размер буфера, байт. */
+
+    /**
+     * @brief Форматирует дробное значение как QString::arg(double): 6 значащих цифр, формат %g.
+     * @param prefix Текст перед числом в UTF-8.
+     * @param value Значение.
+     * @param suffix Текст после числа в UTF-8.
+     * @return true, если текст изменился.
+     */
+    bool format(std::string_view prefix, double value, std::string_view suffix);
+
+    /**
+     * @brief Форматирует целое значение.
+     * @param prefix Текст перед числом в UTF-8.
+     * @param value Значение.
+     * @param suffix Текст после числа в UTF-8.
+     * @return true, если текст изменился.
+     */
+    bool format(std::string_view prefix, long long value, std::string_view suffix);
+
+    /**
+     * @brief Возвращает текущий текст.
+     * @return Текст в UTF-8; действителен до следующего вызова format().
+     */
+    std::string_view text() const { return {current.data(), length}; }
+
+private:
+    /**
+     * @brief Сравнивает собранный текст с текущим и при отличии заменяет его.
+     * @param scratch Собранный текст.
+     * @param size Длина собранного текста.
+     * @return true, если текст изменился.
+     */
+    bool commit(const std::array<char, capacity> &scratch, std::size_t size);
+
+    std::array<char, capacity> current{}; /**< Текущий текст. */
+    std::size_t length = 0; /**< Длина текущего текста. */
+    bool initialized = false; /**< Был ли текст уже сформирован. */
+};
+
+#endif //AIRCONDITIONINGCONTROL_VALUEFORMATTER_H
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "UnitConversion.h"
+#include "Units.h"
+
+/**
+ * @brief Преобразование по одному значению, как в слотах виджета: switch по индексу единиц на каждое значение.
+ * @param in Температуры, °C.
+ * @param out Результат.
+ * @param unitIndex Индекс единиц измерения.
+ */
+static void convertPerValue(const std::vector<float> &in, std::vector<float> &out, int unitIndex) {
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        double tempCelsius = in[i];
+        double value = 0;
+        switch (unitIndex) {
+            case 0:
+                value = tempCelsius;
+                break;
+            case 1:
+                value = tempCelsius + 273.15;
+                break;
+            case 2:
+                value = (tempCelsius * 9 / 5) + 32;
+                break;
+        }
+        out[i] = static_cast<float>(value);
+    }
+}
+
+/**
+ * @brief Преобразование по одному значению с единицами, известными на этапе компиляции.
+ * @param in Температуры, °C.
+ * @param out Результат, °F.
+ */
+static void convertTyped(const std::vector<float> &in, std::vector<float> &out) {
+    for (std::size_t i = 0; i < in.size(); ++i)
+        out[i] = static_cast<float>(quantityCast<Fahrenheit>(Quantity<Celsius>(in[i])).count());
+}
+
+/**
+ * @brief Измеряет минимальное время выполнения функции за несколько повторов.
+ * @param repeats Количество повторов.
+ * @param function Измеряемая функция.
+ * @return Время одного выполнения, с.
+ */
+template<typename Function>
+static double measure(int repeats, Function &&function) {
+    double best = 1e30;
+    for (int i = 0; i < repeats; ++i) {
+        auto started = std::chrono::steady_clock::now();
+        function();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+    }
+    return best;
+}
+
+/**
+ * @brief Сравнивает пакетные реализации преобразования единиц с поэлементным преобразованием.
+ * @return Код возврата; 1, если результаты реализаций расходятся.
+ */
+int main() {
+    constexpr std::size_t count = 1 << 14;
+    constexpr int repeats = 2000;
+    std::vector<float> celsius(count);
+    for (std::size_t i = 0; i < count; ++i)
+        celsius[i] = 16.0f + static_cast<float>(i % 1400) * 0.01f;
+    std::vector<float> reference(count);
+    std::vector<float> out(count);
+
+    std::printf("%zu values, best of %d runs\n", count, repeats);
+    double perValue = measure(repeats, [&] { convertPerValue(celsius, out, 2); });
+    std::printf("%-10s %8.3f ns/value\n", "per-value", perValue * 1e9 / count);
+    double typed = measure(repeats, [&] { convertTyped(celsius, out); });
+    std::printf("%-10s %8.3f ns/value  x%.1f\n", "typed", typed * 1e9 / count, perValue / typed);
+
+    convertTemperatures(celsius, reference, TemperatureUnit::Fahrenheit, ConversionKernel::Scalar);
+    const struct {
+        const char *name;
+        ConversionKernel kernel;
+    } kernels[] = {
+        {"scalar", ConversionKernel::Scalar},
+        {"sse2", ConversionKernel::Sse2},
+        {"avx2", ConversionKernel::Avx2},
+    };
+    int status = 0;
+    for (const auto &entry: kernels) {
+        if (!isConversionKernelSupported(entry.kernel)) {
+            std::printf("%-10s unsupported\n", entry.name);
+            continue;
+        }
+        double seconds = measure(repeats, [&] {
+            convertTemperatures(celsius, out, TemperatureUnit::Fahrenheit, entry.kernel);
+        });
+        bool same = std::memcmp(out.data(), reference.data(), count * sizeof(float)) == 0;
+        std::printf("%-10s %8.3f ns/value  x%.1f%s\n", entry.name, seconds * 1e9 / count, perValue / seconds,
+                    same ? "" : "  MISMATCH");
+        status |= same ? 0 : 1;
+    }
+    return status;
+}
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "FleetStore.h"
+
+/**
+ * @brief Измеряет минимальное время выполнения функции за несколько повторов.
+ * @param repeats Количество повторов.
+ * @param function Измеряемая функция.
+ * @return Время одного выполнения, с.
+ */
+template<typename Function>
+static double measure(int repeats, Function &&function) {
+    double best = 1e30;
+    for (int i = 0; i < repeats; ++i) {
+        auto started = std::chrono::steady_clock::now();
+        function();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count());
+    }
+    return best;
+}
+
+/**
+ * @brief Измеряет стоимость обновления одного поля блока и полного прохода по столбцу уставок.
+ * @return Код возврата.
+ */
+int main() {
+    constexpr std::size_t units = 100000;
+    constexpr std::size_t updates = 1 << 20;
+    constexpr int repeats = 50;
+
+    FleetStore fleet(units);
+    for (std::size_t unit = 0; unit < units; ++unit)
+        fleet.addUnit(16 + static_cast<int>(unit % 15), 101325, 40);
+
+    // Индексы и значения готовятся заранее, чтобы в замер не попал генератор.
+    std::mt19937 random(42);
+    std::uniform_int_distribution<FleetStore::UnitId> pick(0, static_cast<FleetStore::UnitId>(units - 1));
+    std::vector<FleetStore::UnitId> targets(updates);
+    for (auto &target: targets)
+        target = pick(random);
+
+    std::printf("%zu units, best of %d runs\n", units, repeats);
+    double setter = measure(repeats, [&] {
+        int value = 16;
+        for (auto target: targets) {
+            fleet.setSetpoint(target, value);
+            value = value == 30 ? 16 : value + 1;
+        }
+    });
+    std::printf("%-16s %8.3f ns/update\n", "setSetpoint", setter * 1e9 / updates);
+
+    long long checksum = 0;
+    double column = measure(repeats, [&] {
+        auto setpoints = fleet.setpoints();
+        checksum += std::accumulate(setpoints.begin(), setpoints.end(), 0LL);
+    });
+    std::printf("%-16s %8.3f us/pass\n", "setpoint column", column * 1e6);
+    return checksum == 0 ? 1 : 0;
+}
@@ -0,0 +1,135 @@
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QGraphicsRectItem>
+#include <QGraphicsScene>
+#include <QGraphicsTextItem>
+#include <QGraphicsView>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Theme.h"
+
+/**
+ * @brief Переключение темы прежним способом: палитра собирается заново, сцена перебирается целиком.
+ * @param view Окно со сценой.
+ * @param dark Включить ли темную тему.
+ */
+static void toggleByScan(QGraphicsView &view, bool dark) {
+    QPalette palette;
+    palette.setColor(QPalette::Window, dark ? QColor(53, 53, 53) : QColor(255, 255, 255));
+    palette.setColor(QPalette::WindowText, dark ? QColor(255, 255, 255) : QColor(0, 0, 0));
+    palette.setColor(QPalette::Base, dark ? QColor(25, 25, 25) : QColor(240, 240, 240));
+    palette.setColor(QPalette::AlternateBase, dark ? QColor(53, 53, 53) : QColor(255, 255, 255));
+    palette.setColor(QPalette::ToolTipBase, QColor(255, 255, 255));
+    palette.setColor(QPalette::ToolTipText, dark ? QColor(255, 255, 255) : QColor(0, 0, 0));
+    palette.setColor(QPalette::Text, dark ? QColor(255, 255, 255) : QColor(0, 0, 0));
+    palette.setColor(QPalette::Button, dark ? QColor(53, 53, 53) : QColor(240, 240, 240));
+    palette.setColor(QPalette::ButtonText, dark ? QColor(255, 255, 255) : QColor(0, 0, 0));
+    palette.setColor(QPalette::BrightText, QColor(255, 0, 0));
+    palette.setColor(QPalette::Link, dark ? QColor(42, 130, 218) : QColor(0, 0, 255));
+    palette.setColor(QPalette::Highlight, dark ? QColor(42, 130, 218) : QColor(0, 120, 215));
+    palette.setColor(QPalette::HighlightedText, dark ? QColor(0, 0, 0) : QColor(255, 255, 255));
+    view.setPalette(palette);
+
+    QColor color = dark ? Qt::white : Qt::black;
+    for (auto obj: view.scene()->items()) {
+        switch (obj->type()) {
+            case QGraphicsRectItem::Type:
+                qgraphicsitem_cast<QGraphicsRectItem *>(obj)->setPen(QPen(color));
+                break;
+            case QGraphicsTextItem::Type:
+                qgraphicsitem_cast<QGraphicsTextItem *>(obj)->setDefaultTextColor(color);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Переключение темы по заранее построенным палитрам и реестру элементов.
+ * @param view Окно со сценой.
+ * @param items Элементы, окрашиваемые по теме.
+ * @param dark Включить ли темную тему.
+ */
+static void toggleCached(QGraphicsView &view, ThemeRegistry &items, bool dark) {
+    const Theme &theme = dark ? Theme::dark() : Theme::light();
+    view.setPalette(theme.palette());
+    items.apply(theme);
+}
+
+/**
+ * @brief Измеряет задержку переключения темы: сам вызов и вызов вместе с перерисовкой окна.
+ * @param name Название способа.
+ * @param view Окно со сценой.
+ * @param repeats Количество переключений.
+ * @param toggle Функция переключения темы.
+ */
+template<typename Toggle>
+static void measure(const char *name, QGraphicsView &view, int repeats, Toggle &&toggle) {
+    qint64 bestApply = -1;
+    qint64 bestFrame = -1;
+    qint64 totalFrame = 0;
+    QElapsedTimer timer;
+    for (int i = 0; i < repeats; ++i) {
+        timer.start();
+        toggle(i % 2 == 0);
+        qint64 apply = timer.nsecsElapsed();
+        QCoreApplication::processEvents();
+        view.viewport()->repaint();
+        qint64 frame = timer.nsecsElapsed();
+        bestApply = bestApply < 0 ? apply : std::min(bestApply, apply);
+        bestFrame = bestFrame < 0 ? frame : std::min(bestFrame, frame);
+        totalFrame += frame;
+    }
+    std::printf("%-8s apply %8.3f ms  frame %8.3f ms (mean %8.3f ms)\n", name, bestApply / 1e6, bestFrame / 1e6,
+                totalFrame / 1e6 / repeats);
+}
+
+/**
+ * @brief Сравнивает задержку переключения темы на окне с множеством плиток блоков.
+ *
+ * Строка frame показывает стоимость одного кадра при перекраске порциями.
+ * @param argc Количество аргументов командной строки.
+ * @param argv Аргументы: [количество плиток] [количество переключений].
+ * @return Код возврата.
+ */
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    int tiles = argc > 1 ? std::atoi(argv[1]) : 5000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 20;
+    constexpr int columns = 100;
+    constexpr std::size_t itemsPerFrame = 2000; /* Как AirConditioningControl::themeItemsPerFrame. */
+
+    QGraphicsScene scene;
+    ThemeRegistry items;
+    for (int i = 0; i < tiles; ++i) {
+        auto *tile = new QGraphicsRectItem(0, 0, 60, 40);
+        tile->setPos((i % columns) * 64, (i / columns) * 44);
+        scene.addItem(tile);
+        items.addOutline(tile);
+        auto *label = new QGraphicsTextItem(QString::number(i), tile);
+        items.addLabel(label);
+    }
+
+    QGraphicsView view(&scene);
+    view.resize(1280, 800);
+    view.show();
+    QCoreApplication::processEvents();
+
+    std::printf("%d tiles, best of %d toggles\n", tiles, repeats);
+    measure("scan", view, repeats, [&](bool dark) { toggleByScan(view, dark); });
+    measure("cached", view, repeats, [&](bool dark) { toggleCached(view, items, dark); });
+    measure("frame", view, repeats, [&](bool dark) {
+        const Theme &theme = dark ? Theme::dark() : Theme::light();
+        view.setPalette(theme.palette());
+        items.begin(theme);
+        items.step(itemsPerFrame);
+    });
+    return 0;
+}
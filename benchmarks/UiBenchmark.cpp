@@ -0,0 +1,200 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QComboBox>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "AirConditioningControl.h"
+
+/**
+ * @brief Измеряет функцию заданное количество раз и возвращает статистику времени одного вызова.
+ * @param name Название измерения.
+ * @param iterations Количество вызовов.
+ * @param function Измеряемая функция; получает номер вызова.
+ * @return Объект JSON с полями name, iterations, min_ns, median_ns, p90_ns, p99_ns, max_ns.
+ */
+template<typename Function>
+static QJsonObject measure(const char *name, int iterations, Function &&function) {
+    std::vector<qint64> samples(static_cast<std::size_t>(iterations));
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+        timer.start();
+        function(i);
+        samples[static_cast<std::size_t>(i)] = timer.nsecsElapsed();
+    }
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double fraction) {
+        return static_cast<double>(samples[static_cast<std::size_t>(fraction * static_cast<double>(iterations - 1))]);
+    };
+
+    QJsonObject result;
+    result["name"] = name;
+    result["iterations"] = iterations;
+    result["min_ns"] = static_cast<double>(samples.front());
+    result["median_ns"] = percentile(0.5);
+    result["p90_ns"] = percentile(0.9);
+    result["p99_ns"] = percentile(0.99);
+    result["max_ns"] = static_cast<double>(samples.back());
+    std::fprintf(stderr, "%-24s median %10.0f ns  p99 %10.0f ns\n", name, percentile(0.5), percentile(0.99));
+    return result;
+}
+
+/**
+ * @brief Сравнивает медианы с базовыми результатами и отмечает замедления.
+ * @param results Результаты измерений; дополняются полем baseline_ratio.
+ * @param baseline Базовые результаты в том же формате.
+ * @param tolerance Допустимое относительное замедление медианы.
+ * @return Количество измерений, медиана которых превысила допуск.
+ */
+static int compareWithBaseline(QJsonArray &results, const QJsonArray &baseline, double tolerance) {
+    int regressions = 0;
+    for (auto &&entry: results) {
+        QJsonObject result = entry.toObject();
+        for (const auto &reference: baseline) {
+            QJsonObject base = reference.toObject();
+            if (base.value("name") != result.value("name") || base.value("median_ns").toDouble() <= 0)
+                continue;
+            double ratio = result.value("median_ns").toDouble() / base.value("median_ns").toDouble();
+            result["baseline_ratio"] = ratio;
+            if (ratio > 1.0 + tolerance) {
+                ++regressions;
+                std::fprintf(stderr, "REGRESSION %s: x%.2f against baseline\n",
+                             qPrintable(result.value("name").toString()), ratio);
+            }
+        }
+        entry = result;
+    }
+    return regressions;
+}
+
+/**
+ * @brief Измеряет слоты окна управления и ввод-вывод настроек на платформе offscreen.
+ *
+ * Результаты выводятся в формате JSON в стандартный вывод или в файл --output.
+ * С --baseline медианы сравниваются с сохраненными результатами, и при
+ * замедлении больше --tolerance программа завершается с кодом 2.
+ *
+ * @param argc Количество аргументов командной строки.
+ * @param argv Аргументы командной строки.
+ * @return Код возврата.
+ */
+int main(int argc, char *argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption outputOption("output", "Файл результатов JSON (по умолчанию стандартный вывод).", "file");
+    QCommandLineOption baselineOption("baseline", "Файл базовых результатов JSON для сравнения.", "file");
+    QCommandLineOption toleranceOption("tolerance", "Допустимое замедление медианы (доля).", "fraction", "0.25");
+    QCommandLineOption iterationsOption("iterations", "Количество вызовов каждого слота.", "count", "1000");
+    parser.addOption(outputOption);
+    parser.addOption(baselineOption);
+    parser.addOption(toleranceOption);
+    parser.addOption(iterationsOption);
+    parser.process(app);
+    const int iterations = std::max(1, parser.value(iterationsOption).toInt());
+    const QString outputPath =
+        parser.isSet(outputOption) ? QFileInfo(parser.value(outputOption)).absoluteFilePath() : "";
+    const QString baselinePath =
+        parser.isSet(baselineOption) ? QFileInfo(parser.value(baselineOption)).absoluteFilePath() : "";
+
+    // Окно читает и пишет settings.bin в текущем каталоге, поэтому измерения идут во временном.
+    QTemporaryDir workDir;
+    if (!workDir.isValid() || !QDir::setCurrent(workDir.path()))
+        return 1;
+
+    FleetStore fleet;
+    ControlCore core(fleet);
+    FleetStore::UnitId unit = core.addUnit(22, 101325, 45);
+    TelemetryHistory telemetry(8192);
+    telemetry.resize(fleet.size());
+
+    QJsonArray results;
+    results.append(measure("createUI", std::max(1, iterations / 20), [&](int) {
+        AirConditioningControl window(core, telemetry, unit);
+    }));
+
+    AirConditioningControl window(core, telemetry, unit);
+    window.show();
+    QCoreApplication::processEvents();
+
+    results.append(measure("updateTemperature", iterations, [&](int i) {
+        window.updateTemperature(ControlCore::minTemperature + i % 2);
+        window.flushUpdates();
+    }));
+
+    auto combos = window.findChildren<QComboBox *>();
+    auto pressureCombo = std::find_if(combos.begin(), combos.end(), [](QComboBox *combo) {
+        return combo->count() == 2;
+    });
+    if (pressureCombo != combos.end()) {
+        results.append(measure("updatePressureUnits", iterations, [&](int i) {
+            (*pressureCombo)->setCurrentIndex(i % 2);
+            window.flushUpdates();
+        }));
+    }
+
+    results.append(measure("toggleTheme", iterations, [&](int) {
+        window.toggleTheme();
+    }));
+    results.append(measure("rotateAirflow", iterations, [&](int i) {
+        if (i % 2 == 0)
+            window.rotateAirflowLeft();
+        else
+            window.rotateAirflowRight();
+        window.flushUpdates();
+    }));
+    results.append(measure("changeAirflowStrength", iterations, [&](int i) {
+        if (i % 2 == 0)
+            window.increaseAirflow();
+        else
+            window.decreaseAirflow();
+        window.flushUpdates();
+    }));
+
+    const QString xmlPath = workDir.filePath("settings.xml");
+    results.append(measure("saveSettingsToXml", iterations, [&](int) {
+        window.saveSettingsToXml(xmlPath);
+    }));
+    results.append(measure("loadSettingsFromXml", iterations, [&](int) {
+        window.loadSettingsFromXml(xmlPath);
+        window.flushUpdates();
+    }));
+
+    int regressions = 0;
+    if (!baselinePath.isEmpty()) {
+        QFile baselineFile(baselinePath);
+        if (!baselineFile.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "cannot read baseline %s\n", qPrintable(baselinePath));
+            return 1;
+        }
+        QJsonArray baseline = QJsonDocument::fromJson(baselineFile.readAll()).object()["benchmarks"].toArray();
+        regressions = compareWithBaseline(results, baseline, parser.value(toleranceOption).toDouble());
+    }
+
+    QJsonObject report;
+    report["qt"] = qVersion();
+    report["platform"] = QGuiApplication::platformName();
+    report["benchmarks"] = results;
+    QByteArray json = QJsonDocument(report).toJson();
+    if (!outputPath.isEmpty()) {
+        QFile output(outputPath);
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate) || output.write(json) != json.size())
+            return 1;
+    } else {
+        std::fwrite(json.constData(), 1, static_cast<std::size_t>(json.size()), stdout);
+    }
+    return regressions > 0 ? 2 : 0;
+}
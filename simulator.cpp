@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "ControlCore.h"
+#include "ThermalSimulation.h"
+
+/**
+ * @brief Пакетное моделирование парка помещений быстрее реального времени.
+ *
+ * Аргументы: [количество помещений] [часы] [шаг, с] [pid|onoff].
+ * Уставки распределяются по всему допустимому диапазону, все блоки
+ * включены, начальная температура помещений равна среднесуточной наружной.
+ *
+ * @param argc Количество аргументов командной строки.
+ * @param argv Аргументы командной строки.
+ * @return Код возврата.
+ */
+int main(int argc, char *argv[]) {
+    std::size_t rooms = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    double hours = argc > 2 ? std::strtod(argv[2], nullptr) : 24.0;
+    double step = argc > 3 ? std::strtod(argv[3], nullptr) : 1.0;
+    ThermostatConfig thermostat;
+    if (argc > 4 && std::strcmp(argv[4], "onoff") == 0)
+        thermostat.mode = ThermostatConfig::Mode::OnOff;
+    if (rooms == 0 || hours <= 0 || step <= 0) {
+        std::fprintf(stderr, "usage: %s [rooms] [hours] [step] [pid|onoff]\n", argv[0]);
+        return 1;
+    }
+
+    RoomModel room;
+    FleetStore fleet(rooms);
+    ControlCore core(fleet);
+    const int range = ControlCore::maxTemperature - ControlCore::minTemperature + 1;
+    for (std::size_t i = 0; i < rooms; ++i) {
+        auto unit = core.addUnit(ControlCore::minTemperature + static_cast<int>(i % range), 101325, 50);
+        fleet.setPowered(unit, true);
+        fleet.setTemperature(unit, room.outdoorMean);
+    }
+
+    ThermalSimulation simulation(thermostat, room, step);
+    auto started = std::chrono::steady_clock::now();
+    std::size_t steps = simulation.run(fleet, hours * 3600.0);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    double errorSum = 0;
+    double errorMax = 0;
+    for (std::size_t i = 0; i < rooms; ++i) {
+        auto unit = static_cast<FleetStore::UnitId>(i);
+        double error = std::abs(fleet.temperature(unit) - fleet.setpoint(unit));
+        errorSum += error;
+        errorMax = std::max(errorMax, error);
+    }
+
+    std::printf("rooms: %zu\nsimulated: %.1f h (%zu steps of %.3f s)\nwall time: %.3f s\n"
+                "speedup: %.0fx real time\nroom steps/s: %.3g\n"
+                "final |T - setpoint|: mean %.3f, max %.3f\n",
+                rooms, hours, steps, step, wall, hours * 3600.0 / wall,
+                static_cast<double>(steps) * static_cast<double>(rooms) / wall, errorSum / static_cast<double>(rooms),
+                errorMax);
+    return 0;
+}